@@ -0,0 +1,61 @@
+/**
+* If not stated otherwise in this file or this component's LICENSE
+* file the following copyright and licenses apply:
+*
+* Copyright 2024 RDK Management
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+**/
+
+// Stands in for the libmediaplayer module so LibMediaPlayerModule can be loaded and unloaded in tests.
+
+#include "MediaPlayer.h"
+
+namespace
+{
+
+// Fails to close a session opened with "failclose" in its parameters, like a native close that did not go through.
+class StubPlayer : public WPEFramework::Plugin::MediaPlayer
+{
+public:
+    explicit StubPlayer(WPEFramework::Plugin::MediaPlayerObserver* t_observer)
+        : MediaPlayer(t_observer)
+    {
+    }
+
+    bool openMediaPlayer(std::string& t_openParams, WPEFramework::Plugin::ManageMode t_sessionType) override
+    {
+        m_failClose = (std::string::npos != t_openParams.find("failclose"));
+        return true;
+    }
+
+    bool closeMediaPlayer(void) override
+    {
+        return (false == m_failClose);
+    }
+
+private:
+    bool m_failClose = false;
+};
+
+} // namespace
+
+extern "C" WPEFramework::Plugin::MediaPlayer* unifiedCasCreateLibMediaPlayer(WPEFramework::Plugin::MediaPlayerObserver* t_observer)
+{
+    return new StubPlayer(t_observer);
+}
+
+extern "C" void unifiedCasDestroyLibMediaPlayer(WPEFramework::Plugin::MediaPlayer* t_player)
+{
+    delete t_player;
+}
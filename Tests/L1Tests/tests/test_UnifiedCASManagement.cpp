@@ -1,10 +1,29 @@
+#include <atomic>
+#include <condition_variable>
+#include <future>
+#include <mutex>
+#include <set>
+#include <thread>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
 #include <gtest/gtest.h>
 #include <gmock/gmock.h>
 #include "UnifiedCASManagement.h"
 #include "MediaPlayer.h"
+#include "ChunkedSend.h"
+#include "EventBatcher.h"
+#include "EventRing.h"
+#include "LibMediaPlayerModule.h"
+#include "OutboundJson.h"
+#include "PsiCache.h"
+#include "TrafficLog.h"
+#include "UtilsIarm.h"
 
 #include "ServiceMock.h"
 #include "COMLinkMock.h"
+#include "IarmBusMock.h"
 
 using namespace WPEFramework;
 using namespace WPEFramework::Plugin;
@@ -17,7 +36,7 @@ class MockMediaPlayer : public MediaPlayer {
 public:
     MockMediaPlayer() : MediaPlayer(nullptr) {}
 
-    MOCK_METHOD(bool, openMediaPlayer, (std::string&, const std::string&), (override));
+    MOCK_METHOD(bool, openMediaPlayer, (std::string&, ManageMode), (override));
     MOCK_METHOD(bool, closeMediaPlayer, (), (override));
     MOCK_METHOD(bool, requestCASData, (std::string&), (override));
 };
@@ -28,18 +47,84 @@ public:
     void AddRef() const override {}
     uint32_t Release() const override { return 0; }
 
+    // Mirrors the framework: typed handlers receive the request text parsed into their container.
+    template <typename TYPED>
+    static const TYPED& toTyped(const JsonObject& params, TYPED& typed){
+        string text;
+        params.ToString(text);
+        typed.FromString(text);
+        return typed;
+    }
+
     void set_m_player(std::shared_ptr<MediaPlayer> m_player1){
         m_player = m_player1;
     }
     
     uint32_t call_manage(const JsonObject& params, JsonObject& response){
-        return manage(params, response);
+        JsonData::UnifiedCASManagement::ManageParamsData typed;
+        return manage(toTyped(params, typed), response);
     }
     uint32_t call_unmanage(const JsonObject& params, JsonObject& response){
         return unmanage(params, response);
     }
-    uint32_t call_send(const JsonObject& params, JsonObject& response){
-        return send(params, response);
+    uint32_t call_send(const JsonObject& params, JsonObject& response, uint32_t channel = 1){
+        JsonData::UnifiedCASManagement::SendParamsData typed;
+        return send(Core::JSONRPC::Context(channel, 0, ""), toTyped(params, typed), response);
+    }
+
+    uint32_t call_openEventChannel(const JsonObject& params, JsonObject& response, uint32_t channel = 1){
+        return openEventChannel(Core::JSONRPC::Context(channel, 0, ""), params, response);
+    }
+    uint32_t call_closeEventChannel(const JsonObject& params, JsonObject& response, uint32_t channel = 1){
+        return closeEventChannel(Core::JSONRPC::Context(channel, 0, ""), params, response);
+    }
+
+    uint32_t call_setEventFilter(const JsonObject& params, JsonObject& response, uint32_t channel = 1){
+        return setEventFilter(Core::JSONRPC::Context(channel, 0, ""), params, response);
+    }
+    uint32_t call_clearEventFilter(const JsonObject& params, JsonObject& response, uint32_t channel = 1){
+        return clearEventFilter(Core::JSONRPC::Context(channel, 0, ""), params, response);
+    }
+    bool call_sendsDataTo(const std::string& designator, const std::string& payload, const std::string& source, uint32_t sessionId){
+        return sendsDataTo(std::atomic_load(&m_eventFilters), designator, payload, source, sessionId);
+    }
+    uint32_t call_getStatistics(const JsonObject& params, JsonObject& response){
+        return getStatistics(params, response);
+    }
+    uint32_t call_sendBegin(const JsonObject& params, JsonObject& response, uint32_t channel = 1){
+        JsonData::UnifiedCASManagement::SendBeginParamsData typed;
+        return sendBegin(Core::JSONRPC::Context(channel, 0, ""), toTyped(params, typed), response);
+    }
+    uint32_t call_sendChunk(const JsonObject& params, JsonObject& response, uint32_t channel = 1){
+        JsonData::UnifiedCASManagement::SendChunkParamsData typed;
+        return sendChunk(Core::JSONRPC::Context(channel, 0, ""), toTyped(params, typed), response);
+    }
+    uint32_t call_sendEnd(const JsonObject& params, JsonObject& response, uint32_t channel = 1){
+        JsonData::UnifiedCASManagement::SendEndParamsData typed;
+        return sendEnd(Core::JSONRPC::Context(channel, 0, ""), toTyped(params, typed), response);
+    }
+
+    std::shared_ptr<MediaPlayer> get_m_player(){
+        return m_player;
+    }
+
+    bool waitForTeardowns(){
+        std::unique_lock<std::mutex> lock(m_teardown->lock);
+        return m_teardown->signal.wait_for(lock, std::chrono::seconds(5), [this] { return 0 == m_teardown->pending; });
+    }
+
+    void set_m_sessionHash(std::size_t hash){
+        std::lock_guard<std::mutex> lock(m_sessionLock);
+        m_sessionHash = hash;
+    }
+
+    bool addBackend(const std::string& name, std::shared_ptr<MediaPlayer> player){
+        return m_playerRegistry.add(name, [player](MediaPlayerObserver*) { return player; });
+    }
+
+    std::shared_ptr<MediaPlayer> nextPlayer;
+    std::shared_ptr<MediaPlayer> createPlayer() override {
+        return nextPlayer;
     }
 
 
@@ -95,16 +180,87 @@ TEST_F(UnifiedCASManagementTest, PluginInitialize) {
     EXPECT_EQ(plugin->Initialize(mockService), "");
 }
 
-TEST_F(UnifiedCASManagementTest, Deinitialize_ShouldSetInstanceToNullptr) {
-    // Set instance manually to simulate plugin being active
-    UnifiedCASManagement::_instance = plugin;
+TEST_F(UnifiedCASManagementTest, Instances_ShouldKeepSessionsApart) {
+    UnifiedCASManagementTestable other;
+    auto mock = std::make_shared<NiceMock<MockMediaPlayer>>();
+    auto otherMock = std::make_shared<NiceMock<MockMediaPlayer>>();
+    plugin->set_m_player(mock);
+    other.set_m_player(otherMock);
+
+    EXPECT_CALL(*mock, openMediaPlayer(_, ManageMode::MANAGE_FULL)).WillOnce(Return(true));
+    EXPECT_CALL(*otherMock, openMediaPlayer(_, ManageMode::MANAGE_FULL)).WillOnce(Return(true));
+    EXPECT_CALL(*otherMock, closeMediaPlayer()).Times(0);
+
+    JsonObject params;
+    params["mediaurl"] = "tune://tuner?frequency=175000000";
+    params["mode"] = "MODE_NONE";
+    params["manage"] = "MANAGE_FULL";
+    params["casocdmid"] = "cas123";
 
-    plugin->Deinitialize(mockService);  // Call Deinitialize
+    JsonObject first, second, reused;
+    EXPECT_EQ(plugin->call_manage(params, first), 0);
+    params["mediaurl"] = "tune://tuner?frequency=183000000";
+    EXPECT_EQ(other.call_manage(params, second), 0);
+    EXPECT_TRUE(second["success"].Boolean());
 
-    // Now the static _instance should be null
-    EXPECT_EQ(UnifiedCASManagement::_instance, nullptr);
+    // Deactivating one instance leaves the session of the other in place.
+    plugin->Deinitialize(mockService);
+    EXPECT_EQ(other.call_manage(params, reused), 0);
+    EXPECT_EQ(reused["sessionid"].Number(), second["sessionid"].Number());
 }
 
+TEST_F(UnifiedCASManagementTest, Deinitialize_ShouldCloseActiveSession) {
+    auto mock = std::make_shared<NiceMock<MockMediaPlayer>>();
+    plugin->set_m_player(mock);
+
+    EXPECT_CALL(*mock, openMediaPlayer(_, ManageMode::MANAGE_NO_TUNER)).WillOnce(Return(true));
+    EXPECT_CALL(*mock, closeMediaPlayer()).WillOnce(Return(true));
+
+    JsonObject params, response;
+    params["mode"] = "MODE_NONE";
+    params["manage"] = "MANAGE_NO_TUNER";
+    params["casocdmid"] = "cas123";
+    EXPECT_EQ(plugin->call_manage(params, response), 0);
+
+    plugin->Deinitialize(mockService);
+    EXPECT_EQ(plugin->get_m_player(), nullptr);
+}
+
+TEST_F(UnifiedCASManagementTest, Deinitialize_ShouldJoinTeardownsPastDeadline) {
+    ON_CALL(*mockService, ConfigLine()).WillByDefault(Return("{\"draintimeout\":10}"));
+    EXPECT_EQ(plugin->Initialize(mockService), "");
+
+    auto mock = std::make_shared<NiceMock<MockMediaPlayer>>();
+    plugin->set_m_player(mock);
+
+    std::atomic<bool> closed { false };
+    EXPECT_CALL(*mock, openMediaPlayer(_, ManageMode::MANAGE_NO_TUNER)).WillOnce(Return(true));
+    EXPECT_CALL(*mock, closeMediaPlayer()).WillOnce(Invoke([&closed]() {
+        std::this_thread::sleep_for(std::chrono::milliseconds(200));
+        closed = true;
+        return true;
+    }));
+
+    JsonObject params, response;
+    params["mode"] = "MODE_NONE";
+    params["manage"] = "MANAGE_NO_TUNER";
+    params["casocdmid"] = "cas123";
+    EXPECT_EQ(plugin->call_manage(params, response), 0);
+
+    // The teardown overruns the deadline, yet no teardown thread is left running plugin code.
+    plugin->Deinitialize(mockService);
+    EXPECT_TRUE(closed);
+}
+
+TEST_F(UnifiedCASManagementTest, Deinitialize_ShouldRejectNewRequests) {
+    plugin->set_m_player(std::make_shared<NiceMock<MockMediaPlayer>>());
+    plugin->Deinitialize(mockService);
+
+    JsonObject params, response;
+    params["payload"] = "payload";
+    EXPECT_EQ(plugin->call_send(params, response), Core::ERROR_UNAVAILABLE);
+    EXPECT_EQ(response["failurereason"].Number(), UnifiedCASManagement::FAILURE_DEACTIVATING);
+}
 
 TEST_F(UnifiedCASManagementTest, SendInvalidPlayer) {
     JsonObject params, response;
@@ -156,7 +312,7 @@ TEST_F(UnifiedCASManagementTest, Manage_WithValidParams_ShouldSucceed) {
     auto mock = std::make_shared<NiceMock<MockMediaPlayer>>();
     plugin->set_m_player(mock);
 
-    EXPECT_CALL(*mock, openMediaPlayer(_, "MANAGE_FULL")).WillOnce(Return(true));
+    EXPECT_CALL(*mock, openMediaPlayer(_, ManageMode::MANAGE_FULL)).WillOnce(Return(true));
 
     JsonObject params;
     params["mediaurl"] = "http://test.stream";
@@ -170,6 +326,254 @@ TEST_F(UnifiedCASManagementTest, Manage_WithValidParams_ShouldSucceed) {
     EXPECT_TRUE(response["success"].Boolean());
 }
 
+TEST_F(UnifiedCASManagementTest, Manage_UnknownManageValue_ShouldFail) {
+    auto mock = std::make_shared<NiceMock<MockMediaPlayer>>();
+    plugin->set_m_player(mock);
+
+    EXPECT_CALL(*mock, openMediaPlayer(_, _)).Times(0);
+
+    JsonObject params;
+    params["mode"] = "MODE_NONE";
+    params["manage"] = "MANAGE_NONE";
+    params["casocdmid"] = "cas123";
+
+    JsonObject response;
+    EXPECT_EQ(plugin->call_manage(params, response), 1);
+    EXPECT_FALSE(response["success"].Boolean());
+}
+
+TEST_F(UnifiedCASManagementTest, Manage_ShouldUseBackendConfiguredForMode) {
+    auto mock = std::make_shared<NiceMock<MockMediaPlayer>>();
+    ASSERT_TRUE(plugin->addBackend("notuner", mock));
+    ON_CALL(*mockService, ConfigLine()).WillByDefault(Return(
+        "{\"backends\":[{\"manage\":\"MANAGE_NO_TUNER\",\"backend\":\"notuner\"},{\"manage\":\"MANAGE_FULL\",\"backend\":\"unknown\"}]}"));
+    EXPECT_EQ(plugin->Initialize(mockService), "");
+
+    EXPECT_CALL(*mock, openMediaPlayer(_, ManageMode::MANAGE_NO_TUNER)).WillOnce(Return(true));
+
+    JsonObject params;
+    params["mediaurl"] = "http://test.stream";
+    params["mode"] = "MODE_NONE";
+    params["manage"] = "MANAGE_NO_TUNER";
+    params["casocdmid"] = "cas123";
+
+    JsonObject response;
+    EXPECT_EQ(plugin->call_manage(params, response), 0);
+    EXPECT_TRUE(response["success"].Boolean());
+    EXPECT_EQ(plugin->get_m_player(), mock);
+}
+
+TEST_F(UnifiedCASManagementTest, Manage_SameParamsTwice_ShouldReuseSession) {
+    auto mock = std::make_shared<NiceMock<MockMediaPlayer>>();
+    plugin->set_m_player(mock);
+
+    EXPECT_CALL(*mock, openMediaPlayer(_, ManageMode::MANAGE_FULL)).Times(1).WillOnce(Return(true));
+
+    JsonObject params;
+    params["mediaurl"] = "http://test.stream";
+    params["mode"] = "MODE_NONE";
+    params["manage"] = "MANAGE_FULL";
+    params["casinitdata"] = "initData";
+    params["casocdmid"] = "cas123";
+
+    JsonObject first, second;
+    EXPECT_EQ(plugin->call_manage(params, first), 0);
+    params["mediaurl"] = " http://test.stream ";
+    EXPECT_EQ(plugin->call_manage(params, second), 0);
+    EXPECT_TRUE(second["success"].Boolean());
+    EXPECT_EQ(first["sessionid"].Number(), second["sessionid"].Number());
+}
+
+TEST_F(UnifiedCASManagementTest, Manage_DifferentParams_ShouldConflict) {
+    auto mock = std::make_shared<NiceMock<MockMediaPlayer>>();
+    plugin->set_m_player(mock);
+
+    EXPECT_CALL(*mock, openMediaPlayer(_, _)).Times(1).WillOnce(Return(true));
+
+    JsonObject params;
+    params["mediaurl"] = "http://test.stream";
+    params["mode"] = "MODE_NONE";
+    params["manage"] = "MANAGE_FULL";
+    params["casocdmid"] = "cas123";
+
+    JsonObject first, second;
+    EXPECT_EQ(plugin->call_manage(params, first), 0);
+    params["mediaurl"] = "http://other.stream";
+    EXPECT_EQ(plugin->call_manage(params, second), Core::ERROR_ALREADY_CONNECTED);
+    EXPECT_FALSE(second["success"].Boolean());
+    EXPECT_EQ(second["failurereason"].Number(), UnifiedCASManagement::FAILURE_SESSION_CONFLICT);
+
+    // Even with a colliding hash the parameters themselves decide whether the session is reused.
+    plugin->set_m_sessionHash(UnifiedCASManagement::hashManageParams("http://other.stream", ManageMode::MANAGE_FULL, "", "cas123"));
+    JsonObject collided;
+    EXPECT_EQ(plugin->call_manage(params, collided), Core::ERROR_ALREADY_CONNECTED);
+    EXPECT_FALSE(collided.HasLabel("sessionid"));
+}
+
+TEST_F(UnifiedCASManagementTest, Initialize_ShouldRestoreSnapshotSession) {
+    char dir[] = "/tmp/ucasXXXXXX";
+    ASSERT_NE(mkdtemp(dir), nullptr);
+    const string path = string(dir) + "/";
+    ON_CALL(*mockService, VolatilePath()).WillByDefault(Return(path));
+    ON_CALL(*mockService, ConfigLine()).WillByDefault(Return("{\"restoresessions\":true,\"casstateprefix\":\"ENTITLE\"}"));
+
+    JsonObject params;
+    params["mediaurl"] = "http://test.stream";
+    params["mode"] = "MODE_NONE";
+    params["manage"] = "MANAGE_NO_TUNER";
+    params["casocdmid"] = "cas123";
+
+    auto first = std::make_shared<NiceMock<MockMediaPlayer>>();
+    plugin->set_m_player(first);
+    EXPECT_EQ(plugin->Initialize(mockService), "");
+    EXPECT_CALL(*first, openMediaPlayer(_, ManageMode::MANAGE_NO_TUNER)).WillOnce(Return(true));
+
+    JsonObject response;
+    EXPECT_EQ(plugin->call_manage(params, response), 0);
+    plugin->event_data("ENTITLED", "PUBLIC", 1);
+    // Neither other events nor an oversized state replace the recorded CAS state.
+    plugin->event_data("ECM:1234", "PUBLIC", 1);
+    plugin->event_data("ENTITLED" + std::string(SessionSnapshot::MAX_CASSTATE, 'x'), "PUBLIC", 1);
+    plugin->Deinitialize(mockService);
+
+    UnifiedCASManagementTestable* restarted = new UnifiedCASManagementTestable();
+    auto second = std::make_shared<NiceMock<MockMediaPlayer>>();
+    restarted->set_m_player(second);
+    EXPECT_CALL(*second, openMediaPlayer(_, ManageMode::MANAGE_NO_TUNER)).WillOnce(Return(true));
+    EXPECT_EQ(restarted->Initialize(mockService), "");
+
+    JsonObject restoredResponse;
+    EXPECT_EQ(restarted->call_manage(params, restoredResponse), 0);
+    EXPECT_EQ(restoredResponse["sessionid"].Number(), response["sessionid"].Number());
+    EXPECT_TRUE(restoredResponse["restored"].Boolean());
+    EXPECT_EQ(restoredResponse["casstate"].String(), "ENTITLED");
+
+    restarted->Deinitialize(mockService);
+    delete restarted;
+    unlink((path + "sessions.snapshot").c_str());
+    rmdir(dir);
+}
+
+TEST_F(UnifiedCASManagementTest, Unmanage_Deferred_ShouldHandOverPlayer) {
+    auto first = std::make_shared<NiceMock<MockMediaPlayer>>();
+    auto second = std::make_shared<NiceMock<MockMediaPlayer>>();
+    plugin->set_m_player(first);
+    plugin->nextPlayer = second;
+
+    std::promise<void> closed;
+    EXPECT_CALL(*first, openMediaPlayer(_, ManageMode::MANAGE_NO_TUNER)).WillOnce(Return(true));
+    EXPECT_CALL(*first, closeMediaPlayer()).WillOnce(Invoke([&closed]() {
+        closed.set_value();
+        return true;
+    }));
+
+    JsonObject params, response;
+    params["mode"] = "MODE_NONE";
+    params["manage"] = "MANAGE_NO_TUNER";
+    params["casocdmid"] = "cas123";
+    EXPECT_EQ(plugin->call_manage(params, response), 0);
+
+    JsonObject unmanageParams, unmanageResponse;
+    unmanageParams["deferred"] = true;
+    EXPECT_EQ(plugin->call_unmanage(unmanageParams, unmanageResponse), 0);
+    EXPECT_TRUE(unmanageResponse["success"].Boolean());
+    EXPECT_EQ(plugin->get_m_player(), second);
+
+    EXPECT_EQ(closed.get_future().wait_for(std::chrono::seconds(5)), std::future_status::ready);
+}
+
+TEST_F(UnifiedCASManagementTest, Send_ShouldKeepPlayerAliveAcrossDeferredUnmanage) {
+    auto mock = std::make_shared<NiceMock<MockMediaPlayer>>();
+    std::weak_ptr<MediaPlayer> retired = mock;
+    plugin->set_m_player(mock);
+
+    EXPECT_CALL(*mock, openMediaPlayer(_, ManageMode::MANAGE_NO_TUNER)).WillOnce(Return(true));
+    EXPECT_CALL(*mock, closeMediaPlayer()).WillOnce(Return(true));
+    EXPECT_CALL(*mock, requestCASData(_)).WillOnce(Invoke([this, &retired](std::string&) {
+        JsonObject unmanageParams, unmanageResponse;
+        unmanageParams["deferred"] = true;
+        EXPECT_EQ(plugin->call_unmanage(unmanageParams, unmanageResponse), 0);
+        EXPECT_TRUE(plugin->waitForTeardowns());
+        // Retired and torn down, yet still held by the send that is using it.
+        EXPECT_FALSE(retired.expired());
+        return true;
+    }));
+
+    JsonObject params, response;
+    params["mode"] = "MODE_NONE";
+    params["manage"] = "MANAGE_NO_TUNER";
+    params["casocdmid"] = "cas123";
+    EXPECT_EQ(plugin->call_manage(params, response), 0);
+    mock.reset();
+
+    JsonObject sendParams, sendResponse;
+    sendParams["payload"] = "payload";
+    EXPECT_EQ(plugin->call_send(sendParams, sendResponse), 0);
+    EXPECT_TRUE(sendResponse["success"].Boolean());
+    EXPECT_TRUE(retired.expired());
+}
+
+TEST_F(UnifiedCASManagementTest, Manage_HigherPriority_ShouldPreemptSession) {
+    auto background = std::make_shared<NiceMock<MockMediaPlayer>>();
+    auto live = std::make_shared<NiceMock<MockMediaPlayer>>();
+    plugin->set_m_player(background);
+    plugin->nextPlayer = live;
+
+    std::promise<void> closed;
+    EXPECT_CALL(*background, openMediaPlayer(_, ManageMode::MANAGE_NO_TUNER)).WillOnce(Return(true));
+    EXPECT_CALL(*background, closeMediaPlayer()).WillOnce(Invoke([&closed]() {
+        closed.set_value();
+        return true;
+    }));
+    EXPECT_CALL(*live, openMediaPlayer(_, ManageMode::MANAGE_NO_TUNER)).WillOnce(Return(true));
+
+    JsonObject params, first, second, third;
+    params["mediaurl"] = "http://emm.stream";
+    params["mode"] = "MODE_NONE";
+    params["manage"] = "MANAGE_NO_TUNER";
+    params["casocdmid"] = "cas123";
+    params["priority"] = "PRIORITY_BACKGROUND";
+    EXPECT_EQ(plugin->call_manage(params, first), 0);
+
+    params["mediaurl"] = "http://live.stream";
+    params["priority"] = "PRIORITY_LIVE";
+    EXPECT_EQ(plugin->call_manage(params, second), 0);
+    EXPECT_TRUE(second["success"].Boolean());
+    EXPECT_EQ(plugin->get_m_player(), live);
+    EXPECT_EQ(closed.get_future().wait_for(std::chrono::seconds(5)), std::future_status::ready);
+
+    // The lower priority request neither pre-empts nor jumps the live session, and is told how long it would wait.
+    params["mediaurl"] = "http://emm.stream";
+    params["priority"] = "PRIORITY_BACKGROUND";
+    params["waittimeout"] = 50;
+    EXPECT_EQ(plugin->call_manage(params, third), Core::ERROR_ALREADY_CONNECTED);
+    EXPECT_EQ(third["failurereason"].Number(), UnifiedCASManagement::FAILURE_SESSION_CONFLICT);
+    EXPECT_TRUE(third.HasLabel("expectedwait"));
+
+    JsonObject stats;
+    plugin->call_getStatistics(JsonObject(), stats);
+    EXPECT_EQ(stats["scheduler"].Object()["preemptions"].Number(), 1);
+    EXPECT_EQ(stats["scheduler"].Object()["waittimeouts"].Number(), 1);
+}
+
+TEST_F(UnifiedCASManagementTest, Manage_WaitTimeoutAboveMaximum_ShouldBeRejected) {
+    ON_CALL(*mockService, ConfigLine()).WillByDefault(Return("{\"maxwaittimeout\":100}"));
+    EXPECT_EQ(plugin->Initialize(mockService), "");
+    auto mock = std::make_shared<NiceMock<MockMediaPlayer>>();
+    plugin->set_m_player(mock);
+    EXPECT_CALL(*mock, openMediaPlayer(_, _)).Times(0);
+
+    JsonObject params, response;
+    params["mode"] = "MODE_NONE";
+    params["manage"] = "MANAGE_NO_TUNER";
+    params["casocdmid"] = "cas123";
+    params["waittimeout"] = 101;
+    EXPECT_EQ(plugin->call_manage(params, response), Core::ERROR_GENERAL);
+    EXPECT_FALSE(response["success"].Boolean());
+
+    plugin->Deinitialize(mockService);
+}
+
 TEST_F(UnifiedCASManagementTest, Send_RequestCASDataFails_ShouldReturnError) {
     auto mock = std::make_shared<NiceMock<MockMediaPlayer>>();
     plugin->set_m_player(mock);
@@ -187,6 +591,289 @@ TEST_F(UnifiedCASManagementTest, Send_RequestCASDataFails_ShouldReturnError) {
 }
 
 
+TEST_F(UnifiedCASManagementTest, Send_AwaitResponse_ShouldReturnCorrelatedReply) {
+    auto mock = std::make_shared<NiceMock<MockMediaPlayer>>();
+    plugin->set_m_player(mock);
+
+    EXPECT_CALL(*mock, requestCASData(_))
+        .WillOnce(Invoke([this](std::string& data) {
+            JsonObject request(data);
+            JsonObject reply;
+            reply["requestid"] = request["requestid"].Number();
+            reply["status"] = "entitled";
+            string text;
+            reply.ToString(text);
+            plugin->event_data("unrelated", "PUBLIC", 7);
+            plugin->event_data(text, "PUBLIC", 0);
+            return true;
+        }));
+
+    JsonObject params;
+    params["payload"] = "entitlement";
+    params["source"] = "PUBLIC";
+    params["awaitresponse"] = true;
+
+    JsonObject response;
+    EXPECT_EQ(plugin->call_send(params, response), 0);
+    EXPECT_TRUE(response["success"].Boolean());
+    EXPECT_EQ(JsonObject(response["payload"].String())["status"].String(), "entitled");
+}
+
+TEST_F(UnifiedCASManagementTest, Send_AwaitResponse_ShouldTimeOut) {
+    auto mock = std::make_shared<NiceMock<MockMediaPlayer>>();
+    plugin->set_m_player(mock);
+
+    EXPECT_CALL(*mock, requestCASData(_)).WillOnce(Return(true));
+
+    JsonObject params;
+    params["payload"] = "entitlement";
+    params["awaitresponse"] = true;
+    params["timeout"] = 10;
+
+    JsonObject response;
+    EXPECT_EQ(plugin->call_send(params, response), Core::ERROR_TIMEDOUT);
+    EXPECT_EQ(response["failurereason"].Number(), UnifiedCASManagement::FAILURE_REPLY_TIMEOUT);
+}
+
+TEST_F(UnifiedCASManagementTest, Send_ResponseCache_ShouldServeRepeatsUntilFlushed) {
+    ON_CALL(*mockService, ConfigLine()).WillByDefault(Return(
+        "{\"responsecache\":{\"rules\":[{\"prefix\":\"ENT\",\"ttl\":60000}],\"flushon\":[\"ENTITLEMENT_CHANGED\"]}}"));
+    EXPECT_EQ(plugin->Initialize(mockService), "");
+
+    auto mock = std::make_shared<NiceMock<MockMediaPlayer>>();
+    plugin->set_m_player(mock);
+
+    EXPECT_CALL(*mock, requestCASData(_))
+        .Times(2)
+        .WillRepeatedly(Invoke([this](std::string&) {
+            plugin->event_data("ENTITLED", "PUBLIC", 0);
+            return true;
+        }));
+
+    JsonObject params;
+    params["payload"] = "ENT?";
+    params["awaitresponse"] = true;
+
+    JsonObject first, second, third, stats;
+    EXPECT_EQ(plugin->call_send(params, first), 0);
+    EXPECT_EQ(plugin->call_send(params, second), 0);
+    EXPECT_TRUE(second["cached"].Boolean());
+    EXPECT_EQ(second["payload"].String(), "ENTITLED");
+
+    plugin->event_data("ENTITLEMENT_CHANGED", "PUBLIC", 0);
+    EXPECT_EQ(plugin->call_send(params, third), 0);
+    EXPECT_FALSE(third.HasLabel("cached"));
+
+    EXPECT_EQ(plugin->call_getStatistics(JsonObject(), stats), 0);
+    JsonObject cache = stats["responsecache"].Object();
+    EXPECT_EQ(cache["hits"].Number(), 1);
+    EXPECT_EQ(cache["misses"].Number(), 2);
+    EXPECT_EQ(cache["flushes"].Number(), 1);
+}
+
+TEST_F(UnifiedCASManagementTest, Send_Throttle_ShouldRejectClientOverRate) {
+    ON_CALL(*mockService, ConfigLine()).WillByDefault(Return("{\"sendrate\":1,\"sendburst\":2}"));
+    EXPECT_EQ(plugin->Initialize(mockService), "");
+
+    auto mock = std::make_shared<NiceMock<MockMediaPlayer>>();
+    plugin->set_m_player(mock);
+    ON_CALL(*mock, requestCASData(_)).WillByDefault(Return(true));
+
+    JsonObject params;
+    params["payload"] = "query";
+
+    JsonObject response;
+    EXPECT_EQ(plugin->call_send(params, response, 1), 0);
+    EXPECT_EQ(plugin->call_send(params, response, 1), 0);
+    EXPECT_EQ(plugin->call_send(params, response, 1), Core::ERROR_INPROGRESS);
+    EXPECT_EQ(response["failurereason"].Number(), UnifiedCASManagement::FAILURE_RATE_LIMITED);
+
+    JsonObject other;
+    EXPECT_EQ(plugin->call_send(params, other, 2), 0);
+
+    JsonObject stats;
+    EXPECT_EQ(plugin->call_getStatistics(JsonObject(), stats), 0);
+    const JsonArray clients = stats["sendthrottle"].Array();
+    ASSERT_EQ(clients.Length(), 2u);
+    EXPECT_EQ(clients[0].Object()["ratelimited"].Number(), 1);
+    EXPECT_EQ(clients[1].Object()["ratelimited"].Number(), 0);
+}
+
+TEST_F(UnifiedCASManagementTest, Send_Throttle_ShouldCapClientsAndForgetClosedOnes) {
+    ON_CALL(*mockService, ConfigLine()).WillByDefault(Return("{\"sendrate\":1,\"sendburst\":1}"));
+    EXPECT_EQ(plugin->Initialize(mockService), "");
+
+    auto mock = std::make_shared<NiceMock<MockMediaPlayer>>();
+    plugin->set_m_player(mock);
+    ON_CALL(*mock, requestCASData(_)).WillByDefault(Return(true));
+
+    JsonObject params;
+    params["payload"] = "query";
+
+    // Every client has used up its rate, so none of them can be forgotten to make room.
+    JsonObject response;
+    for (uint32_t channel = 1; channel <= SendThrottle::MAX_CLIENTS; channel++) {
+        EXPECT_EQ(plugin->call_send(params, response, channel), 0);
+    }
+    const uint32_t newcomer = SendThrottle::MAX_CLIENTS + 1;
+    EXPECT_EQ(plugin->call_send(params, response, newcomer), Core::ERROR_INPROGRESS);
+    EXPECT_EQ(response["failurereason"].Number(), UnifiedCASManagement::FAILURE_CLIENTS_LIMITED);
+
+    plugin->Close(1);
+    JsonObject admitted;
+    EXPECT_EQ(plugin->call_send(params, admitted, newcomer), 0);
+
+    JsonObject stats;
+    EXPECT_EQ(plugin->call_getStatistics(JsonObject(), stats), 0);
+    EXPECT_EQ(stats["sendthrottle"].Array().Length(), SendThrottle::MAX_CLIENTS);
+}
+
+TEST_F(UnifiedCASManagementTest, PlayerError_Transient_ShouldRebuildSession) {
+    ON_CALL(*mockService, ConfigLine()).WillByDefault(Return(
+        "{\"transienterrors\":[7],\"recoverybackoff\":1}"));
+    EXPECT_EQ(plugin->Initialize(mockService), "");
+
+    auto mock = std::make_shared<NiceMock<MockMediaPlayer>>();
+    plugin->set_m_player(mock);
+
+    std::promise<void> rebuilt;
+    EXPECT_CALL(*mock, openMediaPlayer(_, ManageMode::MANAGE_NO_TUNER))
+        .WillOnce(Return(true))
+        .WillOnce(Return(false))
+        .WillOnce(Invoke([&rebuilt](std::string&, ManageMode) {
+            rebuilt.set_value();
+            return true;
+        }));
+    EXPECT_CALL(*mock, closeMediaPlayer()).Times(3).WillRepeatedly(Return(true));
+
+    JsonObject params;
+    params["mediaurl"] = "http://test.stream";
+    params["mode"] = "MODE_NONE";
+    params["manage"] = "MANAGE_NO_TUNER";
+    params["casocdmid"] = "cas123";
+
+    JsonObject opened;
+    EXPECT_EQ(plugin->call_manage(params, opened), 0);
+    const uint32_t sessionId = opened["sessionid"].Number();
+
+    plugin->onPlayerError(3, sessionId);
+    plugin->onPlayerError(7, sessionId);
+    ASSERT_EQ(rebuilt.get_future().wait_for(std::chrono::seconds(5)), std::future_status::ready);
+
+    // The recovery holds the session until it finished, so manage finds the rebuilt session under the same id.
+    JsonObject reused;
+    EXPECT_EQ(plugin->call_manage(params, reused), 0);
+    EXPECT_EQ(reused["sessionid"].Number(), sessionId);
+
+    JsonObject stats;
+    EXPECT_EQ(plugin->call_getStatistics(JsonObject(), stats), 0);
+    JsonObject recovery = stats["recovery"].Object();
+    EXPECT_EQ(recovery["attempted"].Number(), 1);
+    EXPECT_EQ(recovery["recovered"].Number(), 1);
+    EXPECT_EQ(recovery["failed"].Number(), 0);
+
+    plugin->Deinitialize(mockService);
+}
+
+TEST_F(UnifiedCASManagementTest, SendChunked_ShouldReassemblePayload) {
+    ON_CALL(*mockService, ConfigLine()).WillByDefault(Return("{\"maxtransfersize\":64}"));
+    EXPECT_EQ(plugin->Initialize(mockService), "");
+
+    auto mock = std::make_shared<NiceMock<MockMediaPlayer>>();
+    plugin->set_m_player(mock);
+
+    std::string sent;
+    EXPECT_CALL(*mock, requestCASData(_)).WillOnce(Invoke([&sent](std::string& data) {
+        sent = data;
+        return true;
+    }));
+
+    JsonObject begin, began;
+    begin["size"] = 65;
+    EXPECT_EQ(plugin->call_sendBegin(begin, began), Core::ERROR_INVALID_INPUT_LENGTH);
+    EXPECT_EQ(began["failurereason"].Number(), UnifiedCASManagement::FAILURE_TRANSFER_REJECTED);
+
+    begin["size"] = 10;
+    begin["source"] = "PRIVATE";
+    EXPECT_EQ(plugin->call_sendBegin(begin, began), 0);
+    const uint32_t transferId = began["transferid"].Number();
+
+    JsonObject chunk, chunked;
+    chunk["transferid"] = transferId;
+    chunk["offset"] = 0;
+    chunk["data"] = "EMM\"1";
+    EXPECT_EQ(plugin->call_sendChunk(chunk, chunked), 0);
+    EXPECT_EQ(plugin->call_sendChunk(chunk, chunked), Core::ERROR_INVALID_RANGE);
+    EXPECT_EQ(plugin->call_sendChunk(chunk, chunked, 2), Core::ERROR_UNKNOWN_KEY);
+
+    chunk["offset"] = 5;
+    chunk["data"] = "234567";
+    EXPECT_EQ(plugin->call_sendChunk(chunk, chunked), Core::ERROR_INVALID_INPUT_LENGTH);
+    chunk["data"] = "23456";
+    EXPECT_EQ(plugin->call_sendChunk(chunk, chunked), 0);
+
+    JsonObject end, ended;
+    end["transferid"] = transferId;
+    EXPECT_EQ(plugin->call_sendEnd(end, ended), 0);
+    EXPECT_TRUE(ended["success"].Boolean());
+    EXPECT_EQ(plugin->call_sendEnd(end, ended), Core::ERROR_UNKNOWN_KEY);
+
+    JsonObject request;
+    ASSERT_TRUE(request.FromString(sent));
+    EXPECT_EQ(request["payload"].String(), "EMM\"123456");
+    EXPECT_EQ(request["source"].String(), "PRIVATE");
+}
+
+TEST_F(UnifiedCASManagementTest, Manage_AboveMemoryLimits_ShouldShedUploadsAndRefuseSessions) {
+    ON_CALL(*mockService, ConfigLine()).WillByDefault(Return(
+        "{\"batchwindow\":60000,\"memory\":{\"softlimit\":1024,\"hardlimit\":4096,\"sessionfootprint\":4096}}"));
+    EXPECT_EQ(plugin->Initialize(mockService), "");
+
+    auto mock = std::make_shared<NiceMock<MockMediaPlayer>>();
+    plugin->set_m_player(mock);
+    ON_CALL(*mock, openMediaPlayer(_, _)).WillByDefault(Return(true));
+    ON_CALL(*mock, closeMediaPlayer()).WillByDefault(Return(true));
+
+    JsonObject params;
+    params["mediaurl"] = "http://test.stream";
+    params["mode"] = "MODE_NONE";
+    params["manage"] = "MANAGE_NO_TUNER";
+    params["casocdmid"] = "cas123";
+
+    JsonObject opened, stats;
+    EXPECT_EQ(plugin->call_manage(params, opened), 0);
+    plugin->call_getStatistics(JsonObject(), stats);
+    EXPECT_EQ(stats["memory"].Object()["used"].Number(), 4096);
+    EXPECT_EQ(stats["memory"].Object()["sessions"].Array()[0].Object()["sessionid"].Number(), opened["sessionid"].Number());
+
+    // Over the soft limit, so the event is sent on its own but not queued for a batch.
+    plugin->event_data("ECM", "PUBLIC", opened["sessionid"].Number());
+    plugin->call_getStatistics(JsonObject(), stats);
+    EXPECT_EQ(stats["memory"].Object()["eventsshed"].Number(), 1);
+    EXPECT_EQ(stats["memory"].Object()["used"].Number(), 4096);
+
+    JsonObject begin, began;
+    begin["size"] = 16;
+    EXPECT_EQ(plugin->call_sendBegin(begin, began), Core::ERROR_INPROGRESS);
+    EXPECT_EQ(began["failurereason"].Number(), UnifiedCASManagement::FAILURE_MEMORY_LIMITED);
+
+    JsonObject reused, refused;
+    EXPECT_EQ(plugin->call_manage(params, reused), 0);
+    params["mediaurl"] = "http://other.stream";
+    EXPECT_EQ(plugin->call_manage(params, refused), Core::ERROR_INPROGRESS);
+    EXPECT_EQ(refused["failurereason"].Number(), UnifiedCASManagement::FAILURE_MEMORY_LIMITED);
+
+    JsonObject closed, reopened;
+    EXPECT_EQ(plugin->call_unmanage(JsonObject(), closed), 0);
+    EXPECT_EQ(plugin->call_manage(params, reopened), 0);
+    EXPECT_TRUE(reopened["success"].Boolean());
+
+    plugin->call_getStatistics(JsonObject(), stats);
+    EXPECT_EQ(stats["memory"].Object()["used"].Number(), 4096);
+    EXPECT_EQ(stats["memory"].Object()["transfersrejected"].Number(), 1);
+    EXPECT_EQ(stats["memory"].Object()["sessionsrefused"].Number(), 1);
+}
+
 TEST_F(UnifiedCASManagementTest, InterfaceMapTest_IPlugin) {
     PluginHost::IPlugin* ip = dynamic_cast<PluginHost::IPlugin*>(plugin);
     ASSERT_NE(ip, nullptr); // Ensure interface is found
@@ -210,14 +897,131 @@ TEST_F(UnifiedCASManagementTest, EventData_EmitsCorrectValues)
     EXPECT_EQ(plugin->lastSource, source);
 }
 
+TEST_F(UnifiedCASManagementTest, EventChannel_ShouldCarryDataEvents)
+{
+    JsonObject params, response;
+    EXPECT_EQ(plugin->call_openEventChannel(params, response), 0);
+    ASSERT_TRUE(response["success"].Boolean());
+
+    const std::string name = response["name"].String();
+    const uint32_t size = static_cast<uint32_t>(response["size"].Number());
+    EXPECT_GE(size, EventRing::MIN_CAPACITY);
+
+    plugin->event_data("ringPayload", "PUBLIC");
+
+    int fd = shm_open(name.c_str(), O_RDONLY, 0);
+    ASSERT_GE(fd, 0);
+    struct stat info;
+    ASSERT_EQ(fstat(fd, &info), 0);
+    EXPECT_EQ(info.st_mode & 0777, static_cast<mode_t>(S_IRUSR | S_IWUSR));
+    const EventRing::Header* header = static_cast<const EventRing::Header*>(mmap(nullptr, sizeof(EventRing::Header), PROT_READ, MAP_SHARED, fd, 0));
+    ASSERT_NE(header, MAP_FAILED);
+    const EventRing::Record* record = reinterpret_cast<const EventRing::Record*>(
+        static_cast<const uint8_t*>(mmap(nullptr, header->headerSize + size, PROT_READ, MAP_SHARED, fd, 0)) + header->headerSize);
+    close(fd);
+
+    EXPECT_EQ(header->magic, EventRing::MAGIC);
+    EXPECT_EQ(header->sequence.load(), 1u);
+    EXPECT_EQ(record->type, EventRing::RECORD_DATA);
+    const char* body = reinterpret_cast<const char*>(record + 1);
+    EXPECT_EQ(std::string(body, record->sourceLength), "PUBLIC");
+    EXPECT_EQ(std::string(body + record->sourceLength, record->payloadLength), "ringPayload");
+
+    JsonObject closeResponse;
+    EXPECT_EQ(plugin->call_closeEventChannel(params, closeResponse), 0);
+    EXPECT_EQ(plugin->call_closeEventChannel(params, closeResponse), 1);
+}
+
+TEST_F(UnifiedCASManagementTest, EventChannel_OpensArePerConnection)
+{
+    JsonObject params, response;
+    params["size"] = 65536;
+    EXPECT_EQ(plugin->call_openEventChannel(params, response, 1), 0);
+    const std::string name = response["name"].String();
+
+    // A smaller ring is reported as the one already open, a larger one cannot be had.
+    params["size"] = 1024;
+    EXPECT_EQ(plugin->call_openEventChannel(params, response, 2), 0);
+    EXPECT_EQ(response["size"].Number(), 65536);
+    params["size"] = 2 * 1024 * 1024;
+    EXPECT_EQ(plugin->call_openEventChannel(params, response, 3), 1);
+
+    // Connection 3 never opened it, so it cannot release the opens of the others.
+    JsonObject closeResponse;
+    EXPECT_EQ(plugin->call_closeEventChannel(params, closeResponse, 3), 1);
+
+    plugin->Close(1);
+    int fd = shm_open(name.c_str(), O_RDONLY, 0);
+    EXPECT_GE(fd, 0);
+    if (fd >= 0) {
+        close(fd);
+    }
+
+    plugin->Close(2);
+    EXPECT_LT(shm_open(name.c_str(), O_RDONLY, 0), 0);
+    EXPECT_EQ(plugin->call_closeEventChannel(params, closeResponse, 2), 1);
+}
+
+TEST_F(UnifiedCASManagementTest, EventFilter_SetAndClear)
+{
+    JsonObject params, response;
+    params["id"] = "client.events.1";
+    params["source"] = "PUBLIC";
+    params["sessionid"] = 1;
+    params["prefix"] = "ECM";
+    EXPECT_EQ(plugin->call_setEventFilter(params, response), 0);
+    EXPECT_TRUE(response["success"].Boolean());
+
+    plugin->EmitTestEvent("EMM:1234", "PUBLIC");
+    EXPECT_FALSE(plugin->call_sendsDataTo("client.events.1", plugin->lastPayload, plugin->lastSource, 1));
+    EXPECT_TRUE(plugin->call_sendsDataTo("client.events.2", plugin->lastPayload, plugin->lastSource, 1));
+    plugin->EmitTestEvent("ECM:1234", "PUBLIC");
+    EXPECT_TRUE(plugin->call_sendsDataTo("client.events.1", plugin->lastPayload, plugin->lastSource, 1));
+
+    // Another connection can neither replace nor clear the filter.
+    JsonObject clearParams, clearResponse;
+    clearParams["id"] = "client.events.1";
+    EXPECT_EQ(plugin->call_setEventFilter(params, response, 2), 1);
+    EXPECT_EQ(plugin->call_clearEventFilter(clearParams, clearResponse, 2), 1);
+
+    EXPECT_EQ(plugin->call_clearEventFilter(clearParams, clearResponse), 0);
+    EXPECT_EQ(plugin->call_clearEventFilter(clearParams, clearResponse), 1);
+    EXPECT_TRUE(plugin->call_sendsDataTo("client.events.1", "EMM:1234", "PUBLIC", 1));
+}
+
+TEST_F(UnifiedCASManagementTest, EventFilter_ShouldBeDroppedWhenConnectionCloses)
+{
+    JsonObject params, response;
+    params["id"] = "client.events.1";
+    params["prefix"] = "ECM";
+    EXPECT_EQ(plugin->call_setEventFilter(params, response, 1), 0);
+    params["id"] = "client.events.2";
+    EXPECT_EQ(plugin->call_setEventFilter(params, response, 2), 0);
+
+    plugin->Close(1);
+    EXPECT_TRUE(plugin->call_sendsDataTo("client.events.1", "EMM:1234", "PUBLIC", 1));
+    EXPECT_FALSE(plugin->call_sendsDataTo("client.events.2", "EMM:1234", "PUBLIC", 1));
+
+    // The designator is free again for whichever connection registers it next.
+    params["id"] = "client.events.1";
+    EXPECT_EQ(plugin->call_setEventFilter(params, response, 3), 0);
+}
+
+TEST_F(UnifiedCASManagementTest, EventFilter_MissingId_ShouldFail)
+{
+    JsonObject params, response;
+    params["source"] = "PUBLIC";
+    EXPECT_EQ(plugin->call_setEventFilter(params, response), 1);
+    EXPECT_FALSE(response["success"].Boolean());
+}
 
 class MediaPlayerTest : public ::testing::Test {
 protected:
-    void* dummyCasMgmt = reinterpret_cast<void*>(0x1234); // Mock pointer
+    MediaPlayerObserver* observer = nullptr;
     MediaPlayer* mediaPlayer;
 
     void SetUp() override {
-        mediaPlayer = new MediaPlayer(dummyCasMgmt);
+        mediaPlayer = new MediaPlayer(observer);
     }
 
     void TearDown() override {
@@ -227,8 +1031,7 @@ protected:
 
 TEST_F(MediaPlayerTest, OpenMediaPlayerReturnsTrue) {
     std::string params = "init_params";
-    std::string sessionType = "test_session";
-    EXPECT_TRUE(mediaPlayer->openMediaPlayer(params, sessionType));
+    EXPECT_TRUE(mediaPlayer->openMediaPlayer(params, ManageMode::MANAGE_NO_TUNER));
 }
 
 TEST_F(MediaPlayerTest, CloseMediaPlayerReturnsTrue) {
@@ -240,6 +1043,324 @@ TEST_F(MediaPlayerTest, RequestCASDataReturnsTrue) {
     EXPECT_TRUE(mediaPlayer->requestCASData(data));
 }
 
+TEST(ChunkedSendTest, ReservesDeclaredSizeAndDropsClosedChannels) {
+    ChunkedSend transfers;
+    transfers.configure(1024, 4, 30000);
+
+    uint32_t transferId = 0;
+    ASSERT_EQ(transfers.begin(1, 64, "PUBLIC", transferId), ChunkedSend::ACCEPTED);
+    const std::size_t reserved = transfers.reserved();
+    EXPECT_GE(reserved, 64u);
+
+    // Every byte needs escaping, yet the upload stays within what begin reserved.
+    const std::string quotes(32, '"');
+    EXPECT_EQ(transfers.append(1, transferId, ChunkedSend::NEXT_OFFSET, quotes), ChunkedSend::ACCEPTED);
+    EXPECT_EQ(transfers.append(1, transferId, ChunkedSend::NEXT_OFFSET, quotes), ChunkedSend::ACCEPTED);
+    EXPECT_EQ(transfers.append(1, transferId, ChunkedSend::NEXT_OFFSET, "x"), ChunkedSend::OVERRUN);
+    EXPECT_EQ(transfers.reserved(), reserved);
+
+    std::string message;
+    EXPECT_EQ(transfers.finish(1, transferId, message), ChunkedSend::ACCEPTED);
+    JsonObject request;
+    ASSERT_TRUE(request.FromString(message));
+    EXPECT_EQ(request["payload"].String(), quotes + quotes);
+
+    uint32_t kept = 0, dropped = 0;
+    ASSERT_EQ(transfers.begin(1, 16, "PUBLIC", kept), ChunkedSend::ACCEPTED);
+    ASSERT_EQ(transfers.begin(2, 16, "PUBLIC", dropped), ChunkedSend::ACCEPTED);
+    transfers.drop(2);
+    EXPECT_EQ(transfers.active(), 1u);
+    EXPECT_EQ(transfers.append(2, dropped, 0, "x"), ChunkedSend::UNKNOWN_TRANSFER);
+    EXPECT_EQ(transfers.append(1, kept, 0, "x"), ChunkedSend::ACCEPTED);
+}
+
+TEST(EventBatcherTest, DeliversFullBatchesAndFlushesOnStop) {
+    std::mutex lock;
+    std::condition_variable signal;
+    std::vector<std::vector<EventBatcher::Entry>> batches;
+    EventBatcher batcher;
+    batcher.start(60000, 2, [&](std::vector<EventBatcher::Entry>&& batch) {
+        std::lock_guard<std::mutex> guard(lock);
+        batches.push_back(std::move(batch));
+        signal.notify_all();
+    });
+
+    EXPECT_TRUE(batcher.add("ecm1", "PUBLIC"));
+    EXPECT_TRUE(batcher.add("ecm2", "PUBLIC"));
+    {
+        std::unique_lock<std::mutex> guard(lock);
+        ASSERT_TRUE(signal.wait_for(guard, std::chrono::seconds(5), [&batches]() { return false == batches.empty(); }));
+        ASSERT_EQ(batches.size(), 1u);
+        ASSERT_EQ(batches[0].size(), 2u);
+        EXPECT_EQ(batches[0][0].payload, "ecm1");
+        EXPECT_EQ(batches[0][1].seq, 2u);
+    }
+
+    EXPECT_TRUE(batcher.add("ecm3", "PRIVATE"));
+    batcher.stop();
+    ASSERT_EQ(batches.size(), 2u);
+    EXPECT_EQ(batches[1][0].source, "PRIVATE");
+    EXPECT_FALSE(batcher.add("ecm4", "PUBLIC"));
+}
+
+TEST(EventBatcherTest, DeliversBatchesInSeqOrderOnOneThread) {
+    std::vector<uint64_t> seqs;
+    std::set<std::thread::id> threads;
+    EventBatcher batcher;
+    // Full batches and expired windows both come up at this size and window.
+    batcher.start(1, 3, [&](std::vector<EventBatcher::Entry>&& batch) {
+        threads.insert(std::this_thread::get_id());
+        for (const EventBatcher::Entry& entry : batch) {
+            seqs.push_back(entry.seq);
+        }
+    });
+
+    constexpr uint64_t EVENTS = 500;
+    for (uint64_t event = 0; event < EVENTS; event++) {
+        batcher.add("ecm", "PUBLIC");
+        if (0 == (event % 7)) {
+            std::this_thread::sleep_for(std::chrono::microseconds(500));
+        }
+    }
+    batcher.stop();
+
+    ASSERT_EQ(seqs.size(), EVENTS);
+    for (uint64_t index = 0; index < EVENTS; index++) {
+        EXPECT_EQ(seqs[index], index + 1);
+    }
+    EXPECT_EQ(threads.size(), 1u);
+    EXPECT_EQ(threads.count(std::this_thread::get_id()), 0u);
+}
+
+TEST(EventBatcherTest, SkippedEventsLeaveAGapInSeq) {
+    std::vector<EventBatcher::Entry> delivered;
+    EventBatcher batcher;
+    EXPECT_FALSE(batcher.skip());
+    batcher.start(60000, 100, [&delivered](std::vector<EventBatcher::Entry>&& batch) {
+        delivered.insert(delivered.end(), batch.begin(), batch.end());
+    });
+
+    EXPECT_TRUE(batcher.add("ecm1", "PUBLIC"));
+    EXPECT_TRUE(batcher.skip());
+    EXPECT_TRUE(batcher.add("ecm3", "PUBLIC"));
+    batcher.stop();
+
+    ASSERT_EQ(delivered.size(), 2u);
+    EXPECT_EQ(delivered[0].seq, 1u);
+    EXPECT_EQ(delivered[1].seq, 3u);
+}
+
+TEST(EventBatcherTest, DeliversWhenWindowExpires) {
+    std::promise<size_t> delivered;
+    EventBatcher batcher;
+    batcher.start(10, 100, [&delivered](std::vector<EventBatcher::Entry>&& batch) { delivered.set_value(batch.size()); });
+
+    batcher.add("ecm1", "PUBLIC");
+    std::future<size_t> size = delivered.get_future();
+    ASSERT_EQ(size.wait_for(std::chrono::seconds(5)), std::future_status::ready);
+    EXPECT_EQ(size.get(), 1u);
+    batcher.stop();
+}
+
+TEST(OutboundJsonTest, SerializesSendBody) {
+    const std::string payload = std::string(256, 'x') + "\"quoted\"\n";
+    const std::string source = "PUBLIC";
+
+    const OutboundJson::Field fields[] = { { "payload", payload }, { "source", source }, { "requestid", 7u } };
+    const std::string direct = OutboundJson::serialize(fields, 3);
+
+    JsonObject parsed;
+    ASSERT_TRUE(parsed.FromString(direct));
+    EXPECT_EQ(parsed["payload"].String(), payload);
+    EXPECT_EQ(parsed["source"].String(), source);
+    EXPECT_EQ(parsed["requestid"].Number(), 7);
+}
+
+TEST(LibMediaPlayerModuleTest, MissingModuleFailsOpenWithoutLoading) {
+    auto module = std::make_shared<LibMediaPlayerModule>("/nonexistent/libUnifiedCASLibMediaPlayer.so");
+    LibMediaPlayerProxy player(nullptr, module);
+    std::string params = "{}";
+
+    EXPECT_FALSE(module->loaded());
+    EXPECT_FALSE(player.openMediaPlayer(params, ManageMode::MANAGE_NO_TUNER));
+    EXPECT_FALSE(player.requestCASData(params));
+    EXPECT_FALSE(player.closeMediaPlayer());
+    EXPECT_FALSE(module->loaded());
+    EXPECT_EQ(module->loads(), 0u);
+}
+
+#ifdef LMPLAYER_STUB_MODULE
+TEST(LibMediaPlayerModuleTest, StubModuleIsUnloadedOnlyWhenOptedIn) {
+    auto module = std::make_shared<LibMediaPlayerModule>(LMPLAYER_STUB_MODULE);
+    LibMediaPlayerProxy player(nullptr, module);
+    std::string params = "{}";
+
+    // Unloading is off by default, the module stays loaded without sessions.
+    EXPECT_TRUE(player.openMediaPlayer(params, ManageMode::MANAGE_NO_TUNER));
+    EXPECT_TRUE(module->loaded());
+    EXPECT_TRUE(player.closeMediaPlayer());
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    EXPECT_TRUE(module->loaded());
+    EXPECT_EQ(module->unloads(), 0u);
+
+    module->setUnloadDelay(20);
+    for (int wait = 0; (wait < 500) && module->loaded(); ++wait) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    EXPECT_FALSE(module->loaded());
+    EXPECT_EQ(module->unloads(), 1u);
+
+    // The next session loads it again.
+    EXPECT_TRUE(player.openMediaPlayer(params, ManageMode::MANAGE_NO_TUNER));
+    EXPECT_TRUE(player.requestCASData(params));
+    EXPECT_EQ(module->loads(), 2u);
+    EXPECT_TRUE(player.closeMediaPlayer());
+}
+
+TEST(LibMediaPlayerModuleTest, FailedCloseKeepsThePlayer) {
+    auto module = std::make_shared<LibMediaPlayerModule>(LMPLAYER_STUB_MODULE);
+    LibMediaPlayerProxy player(nullptr, module);
+    std::string params = "{\"failclose\":true}";
+
+    EXPECT_TRUE(player.openMediaPlayer(params, ManageMode::MANAGE_NO_TUNER));
+    EXPECT_FALSE(player.closeMediaPlayer());
+    // Still there: a released player would refuse the request as having no session.
+    EXPECT_TRUE(player.requestCASData(params));
+
+    // Nothing left open, so closing again reports the missing session.
+    std::string reopened = "{}";
+    EXPECT_TRUE(player.openMediaPlayer(reopened, ManageMode::MANAGE_NO_TUNER));
+    EXPECT_TRUE(player.closeMediaPlayer());
+    EXPECT_FALSE(player.closeMediaPlayer());
+}
+
+TEST_F(UnifiedCASManagementTest, Unmanage_NoOpenSession_ShouldFail) {
+    auto module = std::make_shared<LibMediaPlayerModule>(LMPLAYER_STUB_MODULE);
+    plugin->set_m_player(std::make_shared<LibMediaPlayerProxy>(nullptr, module));
+
+    JsonObject params, response;
+    EXPECT_EQ(plugin->call_unmanage(params, response), 1);
+    EXPECT_FALSE(response["success"].Boolean());
+    EXPECT_FALSE(module->loaded());
+}
+#endif
+
+TEST(PsiCacheTest, KeepsLatestVersionOfRecentUrls) {
+    PsiCache cache;
+    cache.configure(2, "{\"psi\"");
+    PsiCache::Entry entry;
+    const auto lookup = [&cache, &entry](uint32_t sessionId, const std::string& url) {
+        const bool hit = cache.open(sessionId, url, entry);
+        cache.confirm(sessionId);
+        return hit;
+    };
+
+    EXPECT_FALSE(lookup(1, "tune://a"));
+    EXPECT_FALSE(cache.report(1, "{\"event\":\"other\"}"));
+    EXPECT_TRUE(cache.report(1, "{\"psi\":\"PAT-PMT-1\",\"version\":1}"));
+    EXPECT_FALSE(cache.report(7, "{\"psi\":\"PAT-PMT-9\",\"version\":9}"));
+
+    EXPECT_TRUE(lookup(2, "tune://a"));
+    EXPECT_EQ(entry.psi, "PAT-PMT-1");
+    EXPECT_EQ(entry.version, 1u);
+    EXPECT_TRUE(cache.report(2, "{\"psi\":\"PAT-PMT-2\",\"version\":2}"));
+    EXPECT_EQ(cache.invalidations(), 1u);
+
+    EXPECT_FALSE(lookup(3, "tune://b"));
+    EXPECT_TRUE(cache.report(3, "{\"psi\":\"B\",\"version\":1}"));
+    EXPECT_FALSE(lookup(4, "tune://c"));
+    EXPECT_TRUE(cache.report(4, "{\"psi\":\"C\",\"version\":1}"));
+
+    // tune://a was used least recently and made room for tune://c.
+    EXPECT_EQ(cache.size(), 2u);
+    EXPECT_FALSE(lookup(5, "tune://a"));
+    EXPECT_TRUE(lookup(6, "tune://c"));
+    EXPECT_EQ(cache.hits(), 2u);
+    EXPECT_EQ(cache.misses(), 4u);
+
+    // A lookup for a session that fails to open is not counted.
+    EXPECT_TRUE(cache.open(7, "tune://c", entry));
+    cache.confirm(8);
+    EXPECT_EQ(cache.hits(), 2u);
+    EXPECT_EQ(cache.misses(), 4u);
+}
+
+TEST(TrafficLogTest, ReadsBackRecordsInOrder) {
+    char path[] = "/tmp/ucastrafficXXXXXX";
+    int fd = mkstemp(path);
+    ASSERT_NE(fd, -1);
+    close(fd);
+
+    {
+        TrafficLog::Writer writer;
+        ASSERT_TRUE(writer.open(path));
+        writer.record(TrafficLog::Kind::MANAGE, 0, "{\"manage\":\"MANAGE_FULL\"}");
+        writer.record(TrafficLog::Kind::SEND, 3, "{\"payload\":\"ping\"}");
+        writer.record(TrafficLog::Kind::SEND_CHUNK, 3, "{\"transferid\":1,\"data\":\"emm\"}");
+        writer.record(TrafficLog::Kind::DATA_EVENT, 1, "pong", "PUBLIC");
+        writer.record(TrafficLog::Kind::PLAYER_ERROR, 1, "", "", -42);
+    }
+
+    TrafficLog::Reader reader;
+    ASSERT_TRUE(reader.open(path));
+    TrafficLog::Record record;
+    uint64_t previousUs = 0;
+    const TrafficLog::Kind kinds[] = { TrafficLog::Kind::MANAGE, TrafficLog::Kind::SEND, TrafficLog::Kind::SEND_CHUNK,
+                                       TrafficLog::Kind::DATA_EVENT, TrafficLog::Kind::PLAYER_ERROR };
+    for (TrafficLog::Kind kind : kinds) {
+        ASSERT_TRUE(reader.next(record));
+        EXPECT_EQ(record.kind, kind);
+        EXPECT_GE(record.timeUs, previousUs);
+        previousUs = record.timeUs;
+        if (TrafficLog::Kind::SEND == kind) {
+            EXPECT_EQ(record.id, 3u);
+            EXPECT_EQ(record.text, "{\"payload\":\"ping\"}");
+        } else if (TrafficLog::Kind::DATA_EVENT == kind) {
+            EXPECT_EQ(record.text, "pong");
+            EXPECT_EQ(record.source, "PUBLIC");
+        }
+        EXPECT_EQ(TrafficLog::isCall(kind), (TrafficLog::Kind::DATA_EVENT != kind) && (TrafficLog::Kind::PLAYER_ERROR != kind));
+    }
+    EXPECT_EQ(record.code, -42);
+    EXPECT_FALSE(reader.next(record));
+    unlink(path);
+}
+
+TEST(TrafficLogTest, IsOwnerOnlyAndStopsAtMaxSize) {
+    char path[] = "/tmp/ucastrafficXXXXXX";
+    int fd = mkstemp(path);
+    ASSERT_NE(fd, -1);
+    fchmod(fd, 0644);
+    close(fd);
+
+    TrafficLog::Writer writer;
+    ASSERT_TRUE(writer.open(path, 64));
+    struct stat info;
+    ASSERT_EQ(stat(path, &info), 0);
+    EXPECT_EQ(info.st_mode & 0777, static_cast<mode_t>(S_IRUSR | S_IWUSR));
+
+    writer.record(TrafficLog::Kind::SEND, 1, "{\"payload\":\"ping\"}");
+    EXPECT_TRUE(writer.active());
+    writer.record(TrafficLog::Kind::SEND, 1, std::string(64, 'x'));
+    EXPECT_FALSE(writer.active());
+    writer.close();
+
+    TrafficLog::Reader reader;
+    ASSERT_TRUE(reader.open(path));
+    TrafficLog::Record record;
+    EXPECT_TRUE(reader.next(record));
+    EXPECT_FALSE(reader.next(record));
+    ASSERT_EQ(stat(path, &info), 0);
+    EXPECT_LE(info.st_size, 64);
+    unlink(path);
+}
+
+TEST(ManageModeTest, ReportsTunerUsePerMode) {
+    EXPECT_TRUE(usesTuner(ManageMode::MANAGE_FULL));
+    EXPECT_FALSE(usesTuner(ManageMode::MANAGE_NO_TUNER));
+    static_assert(ManageNoTunerPolicy::usesTuner == false, "NO_TUNER sessions never hold a tuner");
+}
+
 extern "C" {
     extern const char* MODULE_NAME;
 }
@@ -248,3 +1369,36 @@ TEST(ModuleTest, ModuleNameDeclarationIsAccessible) {
     ASSERT_STREQ(MODULE_NAME, "UnifiedCasManagement");
 }
 
+TEST(IarmConnectorTest, InitWaitsForTheConnectorAndSharesItsAttempts) {
+    NiceMock<IarmBusImplMock> iarm;
+    IarmBus::setImpl(&iarm);
+
+    std::atomic<bool> connected { false };
+    ON_CALL(iarm, IARM_Bus_IsConnected(_, _)).WillByDefault(Invoke([&connected](const char*, int* isRegistered) {
+        *isRegistered = connected ? 1 : 0;
+        return IARM_RESULT_SUCCESS;
+    }));
+    // The first attempt fails, so init() has to wait out one backoff of the connector.
+    EXPECT_CALL(iarm, IARM_Bus_Init(_))
+        .WillOnce(Return(IARM_RESULT_IPCCORE_FAIL))
+        .WillOnce(Return(IARM_RESULT_SUCCESS));
+    EXPECT_CALL(iarm, IARM_Bus_Connect()).WillOnce(Invoke([&connected]() {
+        connected = true;
+        return IARM_RESULT_SUCCESS;
+    }));
+
+    std::promise<void> continued;
+    Utils::IARM::initAsync([&continued]() { continued.set_value(); });
+    EXPECT_TRUE(Utils::IARM::init());
+    EXPECT_TRUE(Utils::IARM::isReady());
+    EXPECT_GE(Utils::IARM::connectTimeMs(), 100u);
+    EXPECT_EQ(continued.get_future().wait_for(std::chrono::seconds(5)), std::future_status::ready);
+
+    // Once connected, continuations run right away and init() makes no further attempts.
+    bool ranInline = false;
+    Utils::IARM::initAsync([&ranInline]() { ranInline = true; });
+    EXPECT_TRUE(ranInline);
+    EXPECT_TRUE(Utils::IARM::init());
+
+    IarmBus::setImpl(nullptr);
+}
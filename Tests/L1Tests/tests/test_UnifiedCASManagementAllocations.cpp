@@ -0,0 +1,110 @@
+#include <cstdlib>
+#include <new>
+#include <gtest/gtest.h>
+#include "UnifiedCASManagement.h"
+#include "MediaPlayer.h"
+#include "OutboundJson.h"
+
+using namespace WPEFramework;
+using namespace WPEFramework::Plugin;
+
+// Replaces the global allocator for this executable only, so the benchmarks below can count the
+// heap allocations of the calling thread without seeing those of unrelated background threads.
+static thread_local bool t_countAllocations = false;
+static thread_local uint32_t t_allocations = 0;
+
+void* operator new(std::size_t size)
+{
+    if (t_countAllocations)
+    {
+        ++t_allocations;
+    }
+    void* memory = malloc((0 != size) ? size : 1);
+    if (nullptr == memory)
+    {
+        throw std::bad_alloc();
+    }
+    return memory;
+}
+
+void operator delete(void* memory) noexcept
+{
+    free(memory);
+}
+
+void operator delete(void* memory, std::size_t) noexcept
+{
+    free(memory);
+}
+
+template <typename FUNCTION>
+static uint32_t countAllocations(FUNCTION&& function)
+{
+    t_allocations = 0;
+    t_countAllocations = true;
+    function();
+    t_countAllocations = false;
+    return t_allocations;
+}
+
+// No client subscribes here, so this measures the plugin's own event path up to Notify: the payload moved
+// through it and serialized once. The per-subscriber fan-out inside Notify is not covered.
+TEST(EventDataAllocationTest, ShouldMovePayloadAndSerializeOnce)
+{
+    UnifiedCASManagement plugin;
+    MediaPlayerObserver& observer = plugin;
+    const std::string message = std::string(256, 'x') + "\"quoted\"\n";
+    const std::string source = "PUBLIC";
+
+    // What the event path did before: a JsonObject copy of the payload, serialized for the log and again by Notify.
+    std::string logged, notified;
+    const uint32_t jsonObjectAllocations = countAllocations([&]() {
+        JsonObject params;
+        params["payload"] = message;
+        params["source"] = source;
+        params.ToString(logged);
+        params.ToString(notified);
+    });
+
+    std::string warmUp = message;
+    observer.onPlayerData(std::move(warmUp), source, 1);
+
+    constexpr uint32_t EVENTS = 100;
+    std::vector<std::string> payloads(EVENTS, message);
+    const uint32_t eventAllocations = countAllocations([&]() {
+        for (std::string& payload : payloads) {
+            observer.onPlayerData(std::move(payload), source, 1);
+        }
+    });
+
+    RecordProperty("JsonObjectAllocationsPerEvent", static_cast<int>(jsonObjectAllocations));
+    RecordProperty("AllocationsPerEvent", static_cast<int>(eventAllocations / EVENTS));
+    // The payload itself is never copied: one allocation for the serialized text, one for the copy Notify takes of it.
+    EXPECT_LE(eventAllocations, 2 * EVENTS);
+    EXPECT_LT(eventAllocations / EVENTS, jsonObjectAllocations);
+}
+
+TEST(OutboundJsonAllocationTest, SerializesSendBodyInOneAllocation) {
+    const std::string payload = std::string(256, 'x') + "\"quoted\"\n";
+    const std::string source = "PUBLIC";
+
+    std::string viaJsonObject;
+    const uint32_t jsonObjectAllocations = countAllocations([&]() {
+        JsonObject jsonParams;
+        jsonParams["payload"] = payload;
+        jsonParams["source"] = source;
+        jsonParams["requestid"] = 7;
+        jsonParams.ToString(viaJsonObject);
+    });
+
+    std::string direct;
+    const uint32_t directAllocations = countAllocations([&]() {
+        const OutboundJson::Field fields[] = { { "payload", payload }, { "source", source }, { "requestid", 7u } };
+        direct = OutboundJson::serialize(fields, 3);
+    });
+
+    RecordProperty("JsonObjectAllocations", static_cast<int>(jsonObjectAllocations));
+    RecordProperty("DirectAllocations", static_cast<int>(directAllocations));
+    EXPECT_EQ(directAllocations, 1u);
+    EXPECT_LT(directAllocations, jsonObjectAllocations);
+}
@@ -0,0 +1,180 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2025 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// ucasreplay - drives a traffic log captured with the "capturefile" configuration back into the
+// plugin, against a player accepting every request, and reports the latency of each call.
+//
+// Usage: ucasreplay <log> [speed]
+//   speed  1 replays at the recorded pace (default), 2 twice as fast, 0 as fast as possible
+//
+// Calls are replayed in order on one thread and player callbacks on another, each at its recorded
+// time, so awaited sends still find their replies. Compare the summary between builds.
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+#include "UnifiedCASManagement.h"
+#include "TrafficLog.h"
+
+using namespace WPEFramework;
+using namespace WPEFramework::Plugin;
+
+namespace {
+
+class ReplayPlayer : public MediaPlayer {
+public:
+    ReplayPlayer() : MediaPlayer(nullptr) {}
+};
+
+class ReplayPlugin : public UnifiedCASManagement {
+public:
+    ReplayPlugin() { m_player = createPlayer(); }
+
+    void AddRef() const override {}
+    uint32_t Release() const override { return 0; }
+
+    std::shared_ptr<MediaPlayer> createPlayer() override {
+        return std::make_shared<ReplayPlayer>();
+    }
+
+    uint32_t call(const TrafficLog::Record& record) {
+        JsonObject response;
+        switch (record.kind) {
+        case TrafficLog::Kind::MANAGE: {
+            JsonData::UnifiedCASManagement::ManageParamsData params;
+            params.FromString(record.text);
+            return manage(params, response);
+        }
+        case TrafficLog::Kind::SEND: {
+            JsonData::UnifiedCASManagement::SendParamsData params;
+            params.FromString(record.text);
+            return send(Core::JSONRPC::Context(record.id, 0, ""), params, response);
+        }
+        // Uploads are numbered like the captured ones too, so the recorded transfer ids still match.
+        case TrafficLog::Kind::SEND_BEGIN: {
+            JsonData::UnifiedCASManagement::SendBeginParamsData params;
+            params.FromString(record.text);
+            return sendBegin(Core::JSONRPC::Context(record.id, 0, ""), params, response);
+        }
+        case TrafficLog::Kind::SEND_CHUNK: {
+            JsonData::UnifiedCASManagement::SendChunkParamsData params;
+            params.FromString(record.text);
+            return sendChunk(Core::JSONRPC::Context(record.id, 0, ""), params, response);
+        }
+        case TrafficLog::Kind::SEND_END: {
+            JsonData::UnifiedCASManagement::SendEndParamsData params;
+            params.FromString(record.text);
+            return sendEnd(Core::JSONRPC::Context(record.id, 0, ""), params, response);
+        }
+        default: {
+            JsonObject params;
+            params.FromString(record.text);
+            return unmanage(params, response);
+        }
+        }
+    }
+
+    void callback(const TrafficLog::Record& record) {
+        // A fresh instance numbers its sessions like the captured one did, so recorded ids still match.
+        if (TrafficLog::Kind::DATA_EVENT == record.kind) {
+            onPlayerData(std::string(record.text), record.source, record.id);
+        } else {
+            onPlayerError(record.code, record.id);
+        }
+    }
+};
+
+struct Latencies {
+    const char* name;
+    std::vector<uint64_t> us;
+    uint32_t failures = 0;
+};
+
+uint64_t percentile(const std::vector<uint64_t>& sorted, uint32_t perMille) {
+    return sorted[std::min<size_t>(sorted.size() - 1, (sorted.size() * perMille) / 1000)];
+}
+
+void waitUntil(std::chrono::steady_clock::time_point start, uint64_t timeUs, double speed) {
+    if (speed > 0) {
+        std::this_thread::sleep_until(start + std::chrono::microseconds(static_cast<uint64_t>(timeUs / speed)));
+    }
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        fprintf(stderr, "Usage: %s <log> [speed]\n", argv[0]);
+        return 1;
+    }
+    const double speed = (argc > 2) ? atof(argv[2]) : 1.0;
+
+    TrafficLog::Reader reader;
+    if (false == reader.open(argv[1])) {
+        fprintf(stderr, "%s is not a traffic log\n", argv[1]);
+        return 1;
+    }
+    std::vector<TrafficLog::Record> calls;
+    std::vector<TrafficLog::Record> callbacks;
+    TrafficLog::Record record;
+    while (reader.next(record)) {
+        (TrafficLog::isCall(record.kind) ? calls : callbacks).push_back(record);
+    }
+    printf("Replaying %zu calls and %zu callbacks at speed %g\n", calls.size(), callbacks.size(), speed);
+
+    ReplayPlugin plugin;
+    // Indexed by kind, the callback kinds stay empty.
+    Latencies latencies[] = { { "manage", {} }, { "send", {} }, { "unmanage", {} }, { "", {} }, { "", {} },
+                              { "sendBegin", {} }, { "sendChunk", {} }, { "sendEnd", {} } };
+    const auto start = std::chrono::steady_clock::now();
+
+    std::thread stack([&]() {
+        for (const TrafficLog::Record& callback : callbacks) {
+            waitUntil(start, callback.timeUs, speed);
+            plugin.callback(callback);
+        }
+    });
+    for (const TrafficLog::Record& call : calls) {
+        waitUntil(start, call.timeUs, speed);
+        const auto issued = std::chrono::steady_clock::now();
+        const uint32_t result = plugin.call(call);
+        Latencies& entry = latencies[static_cast<uint8_t>(call.kind) - static_cast<uint8_t>(TrafficLog::Kind::MANAGE)];
+        entry.us.push_back(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - issued).count());
+        entry.failures += (Core::ERROR_NONE != result) ? 1 : 0;
+    }
+    stack.join();
+
+    const uint64_t wallMs = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start).count();
+    printf("%-10s %8s %8s %10s %10s %10s\n", "method", "calls", "failed", "p50 (us)", "p99 (us)", "max (us)");
+    for (Latencies& entry : latencies) {
+        if (entry.us.empty()) {
+            continue;
+        }
+        std::sort(entry.us.begin(), entry.us.end());
+        printf("%-10s %8zu %8u %10llu %10llu %10llu\n", entry.name, entry.us.size(), entry.failures,
+               static_cast<unsigned long long>(percentile(entry.us, 500)),
+               static_cast<unsigned long long>(percentile(entry.us, 990)),
+               static_cast<unsigned long long>(entry.us.back()));
+    }
+    printf("Replayed in %llu ms\n", static_cast<unsigned long long>(wallMs));
+    return 0;
+}
@@ -0,0 +1,308 @@
+/*
+ * If not stated otherwise in this file or this component's LICENSE file the
+ * following copyright and licenses apply:
+ *
+ * Copyright 2025 RDK Management
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// ucasload - JSON-RPC load generator for the UnifiedCASManagement plugin of a running Thunder.
+//
+// Drives manage/send/unmanage over the JSON-RPC websocket from several connections while further
+// connections only listen to the "data" event, and reports throughput, p50/p99/p99.9 latency and
+// event delivery lag. Unlike the in-process tests this includes Thunder's dispatch, the websocket
+// framing and the Notify fan-out.
+//
+// Usage: ucasload [--host=127.0.0.1:9998] [--callsign=org.rdk.UnifiedCASManagement]
+//                 [--clients=4] [--subscribers=16] [--duration=10] [--rate=0] [--payload=256]
+//                 [--cycle=0] [--await=0] [--manage=MANAGE_NO_TUNER]
+//   clients      connections calling send, each also subscribed to "data"
+//   subscribers  additional connections only subscribed to "data"
+//   duration     run time in seconds
+//   rate         sends per second per client, 0 for back-to-back
+//   payload      send payload size in bytes
+//   cycle        sends after which client 0 unmanages and manages again, 0 to keep the session
+//   await        1 to send with awaitresponse, measuring the CAS round trip
+//
+// Send payloads start with "ucasload:<send time in us>:". Data events carrying such a payload back,
+// as from an echoing CAS, are used to measure delivery lag; other data events are only counted.
+
+#ifndef MODULE_NAME
+#define MODULE_NAME ucasload
+#endif
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <core/core.h>
+#include <websocket/websocket.h>
+
+MODULE_NAME_DECLARATION(BUILD_REFERENCE)
+
+using namespace WPEFramework;
+
+namespace {
+
+typedef JSONRPC::LinkType<Core::JSON::IElement> Link;
+typedef std::chrono::steady_clock Clock;
+
+constexpr uint32_t JSON_TIMEOUT = 5000;
+constexpr const char PAYLOAD_TAG[] = "ucasload:";
+
+struct Options {
+    std::string host = "127.0.0.1:9998";
+    std::string callsign = "org.rdk.UnifiedCASManagement";
+    std::string manage = "MANAGE_NO_TUNER";
+    uint32_t clients = 4;
+    uint32_t subscribers = 16;
+    uint32_t duration = 10;
+    uint32_t rate = 0;
+    uint32_t payload = 256;
+    uint32_t cycle = 0;
+    bool await = false;
+};
+
+bool parseOption(const char* argument, const char* name, std::string& value) {
+    const size_t length = strlen(name);
+    if ((0 == strncmp(argument, "--", 2)) && (0 == strncmp(argument + 2, name, length)) && ('=' == argument[2 + length])) {
+        value = argument + 3 + length;
+        return true;
+    }
+    return false;
+}
+
+bool parseOptions(int argc, char** argv, Options& options) {
+    for (int index = 1; index < argc; ++index) {
+        std::string value;
+        if (parseOption(argv[index], "host", options.host) || parseOption(argv[index], "callsign", options.callsign) ||
+            parseOption(argv[index], "manage", options.manage)) {
+        } else if (parseOption(argv[index], "clients", value)) {
+            options.clients = std::max(1, atoi(value.c_str()));
+        } else if (parseOption(argv[index], "subscribers", value)) {
+            options.subscribers = atoi(value.c_str());
+        } else if (parseOption(argv[index], "duration", value)) {
+            options.duration = atoi(value.c_str());
+        } else if (parseOption(argv[index], "rate", value)) {
+            options.rate = atoi(value.c_str());
+        } else if (parseOption(argv[index], "payload", value)) {
+            options.payload = atoi(value.c_str());
+        } else if (parseOption(argv[index], "cycle", value)) {
+            options.cycle = atoi(value.c_str());
+        } else if (parseOption(argv[index], "await", value)) {
+            options.await = (0 != atoi(value.c_str()));
+        } else {
+            fprintf(stderr, "Unknown option %s\n", argv[index]);
+            return false;
+        }
+    }
+    return true;
+}
+
+uint64_t nowUs() {
+    return std::chrono::duration_cast<std::chrono::microseconds>(Clock::now().time_since_epoch()).count();
+}
+
+// Latencies of one method, in us.
+struct Samples {
+    std::vector<uint64_t> us;
+    uint32_t failures = 0;
+
+    void merge(const Samples& other) {
+        us.insert(us.end(), other.us.begin(), other.us.end());
+        failures += other.failures;
+    }
+};
+
+// Receives the "data" events of one connection.
+class Subscriber {
+public:
+    explicit Subscriber(const std::string& callsign)
+        : _link(callsign) {
+    }
+
+    bool subscribe() {
+        return Core::ERROR_NONE == _link.Subscribe<JsonObject>(JSON_TIMEOUT, _T("data"), &Subscriber::onData, this);
+    }
+
+    void unsubscribe() {
+        _link.Unsubscribe(JSON_TIMEOUT, _T("data"));
+    }
+
+    Link& link() {
+        return _link;
+    }
+
+    void collect(Samples& lag, uint64_t& events) {
+        std::lock_guard<std::mutex> lock(_lock);
+        lag.merge(_lag);
+        events += _events;
+    }
+
+private:
+    void onData(const JsonObject& parameters) {
+        const uint64_t receivedUs = nowUs();
+        const string payload = parameters["payload"].String();
+        std::lock_guard<std::mutex> lock(_lock);
+        ++_events;
+        if (0 == payload.compare(0, sizeof(PAYLOAD_TAG) - 1, PAYLOAD_TAG)) {
+            const uint64_t sentUs = strtoull(payload.c_str() + sizeof(PAYLOAD_TAG) - 1, nullptr, 10);
+            _lag.us.push_back((receivedUs > sentUs) ? (receivedUs - sentUs) : 0);
+        }
+    }
+
+    Link _link;
+    std::mutex _lock;
+    Samples _lag;
+    uint64_t _events = 0;
+};
+
+struct Results {
+    Samples manage;
+    Samples send;
+    Samples unmanage;
+};
+
+uint32_t timedInvoke(Link& link, const char* method, const JsonObject& params, Samples& samples) {
+    JsonObject response;
+    const auto issued = Clock::now();
+    const uint32_t result = link.Invoke<JsonObject, JsonObject>(JSON_TIMEOUT, method, params, response);
+    samples.us.push_back(std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - issued).count());
+    if ((Core::ERROR_NONE != result) || (false == response["success"].Boolean())) {
+        ++samples.failures;
+    }
+    return result;
+}
+
+void runClient(const Options& options, uint32_t index, Subscriber& subscriber, Clock::time_point deadline, Results& results) {
+    JsonObject manageParams;
+    manageParams["mediaurl"] = "tune://ucasload";
+    manageParams["mode"] = "MODE_NONE";
+    manageParams["manage"] = options.manage;
+    manageParams["casocdmid"] = "ucasload";
+    // Every client asks for the same session, so all but the first reuse it.
+    timedInvoke(subscriber.link(), "manage", manageParams, results.manage);
+
+    const std::string padding(options.payload, 'x');
+    const auto interval = (0 == options.rate) ? Clock::duration::zero()
+                                              : std::chrono::duration_cast<Clock::duration>(std::chrono::seconds(1)) / options.rate;
+    auto next = Clock::now();
+    uint32_t sent = 0;
+    while (Clock::now() < deadline) {
+        if (0 != options.rate) {
+            std::this_thread::sleep_until(next);
+            next += interval;
+        }
+        std::string payload = PAYLOAD_TAG + std::to_string(nowUs()) + ":";
+        payload.append(padding, 0, (options.payload > payload.size()) ? (options.payload - payload.size()) : 0);
+
+        JsonObject sendParams;
+        sendParams["payload"] = payload;
+        sendParams["source"] = "PUBLIC";
+        if (options.await) {
+            sendParams["awaitresponse"] = true;
+        }
+        timedInvoke(subscriber.link(), "send", sendParams, results.send);
+
+        if ((0 == index) && (0 != options.cycle) && (0 == (++sent % options.cycle))) {
+            timedInvoke(subscriber.link(), "unmanage", JsonObject(), results.unmanage);
+            timedInvoke(subscriber.link(), "manage", manageParams, results.manage);
+        }
+    }
+}
+
+void report(const char* name, Samples& samples, double seconds) {
+    if (samples.us.empty()) {
+        return;
+    }
+    std::sort(samples.us.begin(), samples.us.end());
+    auto percentile = [&samples](uint32_t perMille) {
+        return static_cast<unsigned long long>(samples.us[std::min<size_t>(samples.us.size() - 1, (samples.us.size() * perMille) / 1000)]);
+    };
+    printf("%-10s %9zu %8u %10.1f %10llu %10llu %10llu %10llu\n", name, samples.us.size(), samples.failures,
+           samples.us.size() / seconds, percentile(500), percentile(990), percentile(999),
+           static_cast<unsigned long long>(samples.us.back()));
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    Options options;
+    if (false == parseOptions(argc, argv, options)) {
+        return 1;
+    }
+    Core::SystemInfo::SetEnvironment(_T("THUNDER_ACCESS"), options.host.c_str());
+
+    const std::string callsign = options.callsign + ".1";
+    std::vector<std::unique_ptr<Subscriber>> connections;
+    for (uint32_t index = 0; index < (options.clients + options.subscribers); ++index) {
+        connections.emplace_back(new Subscriber(callsign));
+        if (false == connections.back()->subscribe()) {
+            fprintf(stderr, "Failed to subscribe to %s over %s\n", callsign.c_str(), options.host.c_str());
+            return 1;
+        }
+    }
+    printf("%u clients and %u subscribers connected to %s, running for %u s\n",
+           options.clients, options.subscribers, options.host.c_str(), options.duration);
+
+    std::vector<Results> results(options.clients);
+    std::vector<std::thread> clients;
+    const auto started = Clock::now();
+    const auto deadline = started + std::chrono::seconds(options.duration);
+    for (uint32_t index = 0; index < options.clients; ++index) {
+        clients.emplace_back(runClient, std::cref(options), index, std::ref(*connections[index]), deadline, std::ref(results[index]));
+    }
+    for (std::thread& client : clients) {
+        client.join();
+    }
+    const double seconds = std::chrono::duration_cast<std::chrono::duration<double>>(Clock::now() - started).count();
+
+    JsonObject response;
+    connections.front()->link().Invoke<JsonObject, JsonObject>(JSON_TIMEOUT, "unmanage", JsonObject(), response);
+    // Let the events still in flight arrive before counting them.
+    std::this_thread::sleep_for(std::chrono::milliseconds(500));
+
+    Results total;
+    for (const Results& result : results) {
+        total.manage.merge(result.manage);
+        total.send.merge(result.send);
+        total.unmanage.merge(result.unmanage);
+    }
+    Samples lag;
+    uint64_t events = 0;
+    for (std::unique_ptr<Subscriber>& connection : connections) {
+        connection->collect(lag, events);
+        connection->unsubscribe();
+    }
+    connections.clear();
+
+    printf("%-10s %9s %8s %10s %10s %10s %10s %10s\n", "method", "calls", "failed", "per s", "p50 (us)", "p99 (us)", "p99.9 (us)", "max (us)");
+    report("manage", total.manage, seconds);
+    report("send", total.send, seconds);
+    report("unmanage", total.unmanage, seconds);
+    report("eventlag", lag, seconds);
+    printf("%llu data events delivered (%.1f per s), %zu carried a send time\n",
+           static_cast<unsigned long long>(events), events / seconds, lag.us.size());
+
+    Core::Singleton::Dispose();
+    return 0;
+}
@@ -24,6 +24,15 @@
 #include "libIBus.h"
 #include <unistd.h>
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
 #define IARM_CHECK(FUNC) { \
     if ((res = FUNC) != IARM_RESULT_SUCCESS) { \
         LOGINFO("IARM %s: %s", #FUNC, \
@@ -40,39 +49,66 @@
 
 namespace Utils {
 struct IARM {
+    /**
+     * @brief Connects to the bus, blocking the caller until the connector started by initAsync()
+     *        reports it connected or INIT_TIMEOUT_MS pass.
+     */
     static bool init()
     {
-        IARM_Result_t res;
-        bool result = false;
+        initAsync();
 
-        if (isConnected()) {
-            LOGINFO("IARM already connected");
-            result = true;
-        } else {
-            unsigned int retryCount = 0;
-            do
-            {
-                res = IARM_Bus_Init(NAME);
-                LOGINFO("IARM_Bus_Init: %d", res);
-                if (res == IARM_RESULT_SUCCESS || res == IARM_RESULT_INVALID_STATE /* already inited or connected */) {
-                    res = IARM_Bus_Connect();
-                    LOGINFO("IARM_Bus_Connect: %d", res);
-                    if (res == IARM_RESULT_SUCCESS || res == IARM_RESULT_INVALID_STATE /* already connected or not inited */) {
-                        result = isConnected();
-                        LOGERR("ARM_Bus_Connect result: %d res: %d retryCount :%d ",result, res, retryCount);
-                    } else {
-                        LOGERR("IARM_Bus_Connect failure:result :%d res: %d retryCount :%d ",result, res, retryCount);
-                    }
-                } else {
-                    LOGERR("IARM_Bus_Init failure: result :%d res: %d retryCount :%d",result, res,retryCount);
-                }
-
-                if(result == false) usleep(100000);
-
-            }while((result == false) && (retryCount++ < 20));
+        Connector& state = connector();
+        std::unique_lock<std::mutex> lock(state.lock);
+        if (false == state.signal.wait_for(lock, std::chrono::milliseconds(INIT_TIMEOUT_MS), [&state] { return state.ready.load(); })) {
+            LOGERR("IARM not connected after %u ms", INIT_TIMEOUT_MS);
+            return false;
         }
+        return true;
+    }
 
-        return result;
+    /**
+     * @brief Connects to the bus on a background thread instead of blocking the caller.
+     * @details The connector retries with exponential backoff (100 ms doubling up to 5 s) until it
+     *          succeeds. It is started once per process; further calls only add continuations.
+     *          The continuation runs on the connector thread once the bus is connected, or right away
+     *          on the calling thread if it already is. The connector is never torn down: it may be
+     *          blocked in IARM_Bus_Init at process exit, so it is detached rather than joined.
+     */
+    static void initAsync(std::function<void()>&& continuation = nullptr)
+    {
+        Connector& state = connector();
+        std::unique_lock<std::mutex> lock(state.lock);
+
+        if (state.ready) {
+            lock.unlock();
+            if (continuation) {
+                continuation();
+            }
+            return;
+        }
+        if (continuation) {
+            state.continuations.push_back(std::move(continuation));
+        }
+        if (false == state.started) {
+            state.started = true;
+            std::thread(&IARM::connectLoop).detach();
+        }
+    }
+
+    /**
+     * @brief Whether the connector started by initAsync() has connected the bus.
+     */
+    static bool isReady()
+    {
+        return connector().ready.load();
+    }
+
+    /**
+     * @brief Time in ms the connector took from initAsync() to a connected bus, 0 before that.
+     */
+    static uint32_t connectTimeMs()
+    {
+        return connector().connectTimeMs.load();
     }
 
     static bool isConnected()
@@ -80,11 +116,82 @@ struct IARM {
         IARM_Result_t res;
         int isRegistered = 0;
         res = IARM_Bus_IsConnected(NAME, &isRegistered);
-        LOGINFO("IARM_Bus_IsConnected: res:%d  isRegistered (%d)", res, isRegistered);
+        if (res != IARM_RESULT_SUCCESS) {
+            LOGINFO("IARM_Bus_IsConnected: res:%d  isRegistered (%d)", res, isRegistered);
+        }
 
         return (isRegistered == 1);
     }
 
     static constexpr const char* NAME = "Thunder_Plugins";
+    static constexpr uint32_t INIT_TIMEOUT_MS = 2000;
+
+private:
+    struct Connector {
+        std::mutex lock; // Protects the continuations and started
+        std::condition_variable signal; // Wakes init() callers once the bus is connected
+        std::vector<std::function<void()>> continuations;
+        bool started = false;
+        std::atomic<bool> ready { false };
+        std::atomic<uint32_t> connectTimeMs { 0 };
+    };
+
+    static Connector& connector()
+    {
+        // Deliberately leaked, the detached connector thread may still use it during process exit.
+        static Connector* instance = new Connector();
+        return *instance;
+    }
+
+    static bool connectOnce(unsigned int retryCount)
+    {
+        IARM_Result_t res;
+        bool result = false;
+
+        res = IARM_Bus_Init(NAME);
+        LOGINFO("IARM_Bus_Init: %d", res);
+        if (res == IARM_RESULT_SUCCESS || res == IARM_RESULT_INVALID_STATE /* already inited or connected */) {
+            res = IARM_Bus_Connect();
+            LOGINFO("IARM_Bus_Connect: %d", res);
+            if (res == IARM_RESULT_SUCCESS || res == IARM_RESULT_INVALID_STATE /* already connected or not inited */) {
+                result = isConnected();
+                LOGINFO("IARM_Bus_Connect result: %d res: %d retryCount :%d ",result, res, retryCount);
+            } else {
+                LOGERR("IARM_Bus_Connect failure:result :%d res: %d retryCount :%d ",result, res, retryCount);
+            }
+        } else {
+            LOGERR("IARM_Bus_Init failure: result :%d res: %d retryCount :%d",result, res,retryCount);
+        }
+        return result;
+    }
+
+    static void connectLoop()
+    {
+        Connector& state = connector();
+        const auto started = std::chrono::steady_clock::now();
+        std::chrono::milliseconds backoff(100);
+        unsigned int retryCount = 0;
+
+        while ((false == isConnected()) && (false == connectOnce(retryCount))) {
+            std::this_thread::sleep_for(backoff);
+            backoff = std::min(backoff * 2, std::chrono::milliseconds(5000));
+            ++retryCount;
+        }
+
+        state.connectTimeMs = static_cast<uint32_t>(std::chrono::duration_cast<std::chrono::milliseconds>(
+                                  std::chrono::steady_clock::now() - started).count());
+        LOGINFO("IARM connected after %u ms, %u retries", state.connectTimeMs.load(), retryCount);
+
+        std::vector<std::function<void()>> continuations;
+        {
+            std::lock_guard<std::mutex> lock(state.lock);
+            state.ready = true;
+            continuations.swap(state.continuations);
+        }
+        state.signal.notify_all();
+        for (std::function<void()>& continuation : continuations) {
+            continuation();
+        }
+    }
 };
 }
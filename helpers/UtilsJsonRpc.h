@@ -85,6 +85,15 @@
     Notify(event,params); \
 }
 
+// For parameters the caller serialized and logged itself; sendIf picks the clients as with Notify.
+#define sendNotifySerialized(event,params) { \
+    Notify(event,params); \
+}
+
+#define sendNotifySerializedIf(event,params,sendIf) { \
+    Notify(event,params,sendIf); \
+}
+
 #else
 
 #define sendNotify(event,params) { \
@@ -100,6 +109,14 @@
     for (uint8_t i = 1; GetHandler(i); i++) GetHandler(i)->Notify(event,params); \
 }
 
+#define sendNotifySerialized(event,params) { \
+    for (uint8_t i = 1; GetHandler(i); i++) GetHandler(i)->Notify(event,params); \
+}
+
+#define sendNotifySerializedIf(event,params,sendIf) { \
+    for (uint8_t i = 1; GetHandler(i); i++) GetHandler(i)->Notify(event,params,sendIf); \
+}
+
 #endif
 /**
  * DO NOT USE THIS.
@@ -0,0 +1,172 @@
+/**
+* If not stated otherwise in this file or this component's LICENSE
+* file the following copyright and licenses apply:
+*
+* Copyright 2024 RDK Management
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+**/
+
+
+#include "Module.h"
+#include "ChunkedSend.h"
+#include "OutboundJson.h"
+#include "UtilsLogging.h"
+
+namespace WPEFramework
+{
+
+namespace Plugin
+{
+
+static const char FRAME_PREFIX[] = "{\"payload\":\"";
+static const char FRAME_SOURCE[] = "\",\"source\":\"";
+static const char FRAME_SUFFIX[] = "\"}";
+
+void ChunkedSend::configure(uint32_t t_maxSize, uint32_t t_maxTransfers, uint32_t t_idleTimeoutMs)
+{
+    std::lock_guard<std::mutex> lock(m_lock);
+
+    m_maxSize = t_maxSize;
+    m_maxTransfers = t_maxTransfers;
+    m_idleTimeoutMs = t_idleTimeoutMs;
+    m_transfers.clear();
+}
+
+ChunkedSend::Status ChunkedSend::begin(uint32_t t_channelId, uint32_t t_size, const std::string& t_source, uint32_t& t_transferId)
+{
+    std::lock_guard<std::mutex> lock(m_lock);
+
+    if (t_size > m_maxSize)
+    {
+        return TOO_LARGE;
+    }
+
+    const Clock::time_point now = Clock::now();
+    std::map<uint32_t, Transfer>::iterator transfer = m_transfers.begin();
+    while (transfer != m_transfers.end())
+    {
+        if ((now - transfer->second.lastActivity) > std::chrono::milliseconds(m_idleTimeoutMs))
+        {
+            LOGWARN("Dropping transfer %u of channel %u, idle for more than %u ms", transfer->first, transfer->second.channelId, m_idleTimeoutMs);
+            transfer = m_transfers.erase(transfer);
+        }
+        else
+        {
+            ++transfer;
+        }
+    }
+    if (m_transfers.size() >= m_maxTransfers)
+    {
+        return TOO_MANY;
+    }
+
+    t_transferId = ++m_nextTransferId;
+    Transfer& created = m_transfers[t_transferId];
+    created.channelId = t_channelId;
+    created.size = t_size;
+    created.received = 0;
+    created.source = t_source;
+    created.lastActivity = now;
+    // Kept raw: escaping can grow the payload up to six times, the declared size is what was agreed to.
+    created.payload.reserve(t_size);
+    return ACCEPTED;
+}
+
+ChunkedSend::Status ChunkedSend::append(uint32_t t_channelId, uint32_t t_transferId, uint32_t t_offset, const std::string& t_data)
+{
+    std::lock_guard<std::mutex> lock(m_lock);
+
+    std::map<uint32_t, Transfer>::iterator transfer = m_transfers.find(t_transferId);
+    if ((m_transfers.end() == transfer) || (t_channelId != transfer->second.channelId))
+    {
+        return UNKNOWN_TRANSFER;
+    }
+    if ((NEXT_OFFSET != t_offset) && (t_offset != transfer->second.received))
+    {
+        return OUT_OF_ORDER;
+    }
+    if (t_data.size() > (transfer->second.size - transfer->second.received))
+    {
+        return OVERRUN;
+    }
+
+    transfer->second.payload.append(t_data);
+    transfer->second.received += static_cast<uint32_t>(t_data.size());
+    transfer->second.lastActivity = Clock::now();
+    return ACCEPTED;
+}
+
+ChunkedSend::Status ChunkedSend::finish(uint32_t t_channelId, uint32_t t_transferId, std::string& t_message)
+{
+    std::lock_guard<std::mutex> lock(m_lock);
+
+    std::map<uint32_t, Transfer>::iterator transfer = m_transfers.find(t_transferId);
+    if ((m_transfers.end() == transfer) || (t_channelId != transfer->second.channelId))
+    {
+        return UNKNOWN_TRANSFER;
+    }
+    if (transfer->second.received != transfer->second.size)
+    {
+        m_transfers.erase(transfer);
+        return INCOMPLETE;
+    }
+
+    const std::string& payload = transfer->second.payload;
+    t_message.clear();
+    t_message.reserve(sizeof(FRAME_PREFIX) + OutboundJson::escapedSize(payload) + sizeof(FRAME_SOURCE) +
+                      OutboundJson::escapedSize(transfer->second.source) + sizeof(FRAME_SUFFIX));
+    t_message = FRAME_PREFIX;
+    OutboundJson::appendEscaped(t_message, payload);
+    t_message += FRAME_SOURCE;
+    OutboundJson::appendEscaped(t_message, transfer->second.source);
+    t_message += FRAME_SUFFIX;
+    m_transfers.erase(transfer);
+    return ACCEPTED;
+}
+
+void ChunkedSend::drop(uint32_t t_channelId)
+{
+    std::lock_guard<std::mutex> lock(m_lock);
+    for (std::map<uint32_t, Transfer>::iterator transfer = m_transfers.begin(); transfer != m_transfers.end();)
+    {
+        transfer = (t_channelId == transfer->second.channelId) ? m_transfers.erase(transfer) : std::next(transfer);
+    }
+}
+
+void ChunkedSend::clear()
+{
+    std::lock_guard<std::mutex> lock(m_lock);
+    m_transfers.clear();
+}
+
+uint32_t ChunkedSend::active()
+{
+    std::lock_guard<std::mutex> lock(m_lock);
+    return static_cast<uint32_t>(m_transfers.size());
+}
+
+std::size_t ChunkedSend::reserved()
+{
+    std::lock_guard<std::mutex> lock(m_lock);
+    std::size_t bytes = 0;
+    for (const auto& transfer : m_transfers)
+    {
+        bytes += transfer.second.payload.capacity();
+    }
+    return bytes;
+}
+
+} // namespace Plugin
+
+} // namespace WPEFramework
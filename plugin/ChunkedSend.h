@@ -0,0 +1,150 @@
+/**
+* If not stated otherwise in this file or this component's LICENSE
+* file the following copyright and licenses apply:
+*
+* Copyright 2024 RDK Management
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+**/
+
+
+#ifndef CHUNKEDSEND_H
+#define CHUNKEDSEND_H
+
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <string>
+
+namespace WPEFramework
+{
+
+namespace Plugin
+{
+
+/**
+ * @brief   Reassembly of payloads uploaded in chunks with sendBegin/sendChunk/sendEnd.
+ * @details Each transfer owns one buffer, reserved at begin for the declared size, that the raw chunks
+ *          are appended to. Finishing a transfer escapes it once into the request frame. Memory held
+ *          between calls is bounded by the configured transfer size and count; transfers left idle
+ *          longer than the timeout are dropped when a new one begins, those of a channel when it closes.
+ */
+class ChunkedSend
+{
+
+public:
+    static constexpr uint32_t NEXT_OFFSET = UINT32_MAX; //Appends a chunk without checking its offset
+
+    enum Status : uint8_t
+    {
+        ACCEPTED,
+        UNKNOWN_TRANSFER, //No such transfer, or it belongs to another channel
+        TOO_LARGE, //The declared size exceeds the configured maximum
+        TOO_MANY, //The configured number of transfers is in progress
+        OUT_OF_ORDER, //The chunk offset is not the number of bytes received so far
+        OVERRUN, //The chunk exceeds the declared size
+        INCOMPLETE //Fewer bytes than declared were received
+    };
+
+    ChunkedSend() = default;
+    ChunkedSend(const ChunkedSend&) = delete;
+    ChunkedSend& operator=(const ChunkedSend&) = delete;
+
+    /**
+     * @brief     This method sets the limits and drops all transfers.
+     *
+     * @parm[in]  t_maxSize       Largest payload in bytes a transfer may declare.
+     * @parm[in]  t_maxTransfers  Transfers that may be in progress at once.
+     * @parm[in]  t_idleTimeoutMs Time after which an idle transfer may be dropped.
+     *
+     * @return    None
+     */
+    void configure(uint32_t t_maxSize, uint32_t t_maxTransfers, uint32_t t_idleTimeoutMs);
+
+    /**
+     * @brief     This method starts a transfer.
+     *
+     * @parm[in]  t_channelId  JSON-RPC channel owning the transfer.
+     * @parm[in]  t_size       Payload size in bytes.
+     * @parm[in]  t_source     Origin of the data, sent along with the payload.
+     * @parm[out] t_transferId Identifier of the new transfer.
+     *
+     * @return    ACCEPTED, TOO_LARGE or TOO_MANY.
+     */
+    Status begin(uint32_t t_channelId, uint32_t t_size, const std::string& t_source, uint32_t& t_transferId);
+
+    /**
+     * @brief     This method appends a chunk to a transfer.
+     *
+     * @parm[in]  t_offset Offset of the chunk in the payload, or NEXT_OFFSET.
+     *
+     * @return    ACCEPTED, UNKNOWN_TRANSFER, OUT_OF_ORDER or OVERRUN. A rejected chunk leaves the transfer as it was.
+     */
+    Status append(uint32_t t_channelId, uint32_t t_transferId, uint32_t t_offset, const std::string& t_data);
+
+    /**
+     * @brief     This method completes a transfer and removes it.
+     *
+     * @parm[out] t_message Request frame carrying the payload and source.
+     *
+     * @return    ACCEPTED, UNKNOWN_TRANSFER or INCOMPLETE. An incomplete transfer is removed as well.
+     */
+    Status finish(uint32_t t_channelId, uint32_t t_transferId, std::string& t_message);
+
+    /**
+     * @brief     This method drops the transfers of a channel that closed.
+     *
+     * @parm[in]  t_channelId JSON-RPC channel owning the transfers.
+     *
+     * @return    None
+     */
+    void drop(uint32_t t_channelId);
+
+    void clear();
+
+    uint32_t active();
+
+    /**
+     * @brief     This method reports the memory reserved by the transfers in progress.
+     *
+     * @return    Bytes reserved for the payloads of all transfers.
+     */
+    std::size_t reserved();
+
+private:
+    typedef std::chrono::steady_clock Clock;
+
+    struct Transfer
+    {
+        uint32_t          channelId;
+        uint32_t          size; //Declared payload size
+        uint32_t          received; //Payload bytes appended so far
+        std::string       payload; //Raw payload received so far
+        std::string       source;
+        Clock::time_point lastActivity;
+    };
+
+    std::mutex                   m_lock; //Protects the limits and transfers
+    uint32_t                     m_maxSize = 1024 * 1024;
+    uint32_t                     m_maxTransfers = 4;
+    uint32_t                     m_idleTimeoutMs = 30000;
+    uint32_t                     m_nextTransferId = 0;
+    std::map<uint32_t, Transfer> m_transfers;
+};
+
+} // namespace Plugin
+
+} // namespace WPEFramework
+
+#endif /* CHUNKEDSEND_H */
@@ -0,0 +1,150 @@
+/**
+* If not stated otherwise in this file or this component's LICENSE
+* file the following copyright and licenses apply:
+*
+* Copyright 2024 RDK Management
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+**/
+
+#include "Module.h"
+#include "EventBatcher.h"
+
+namespace WPEFramework
+{
+
+namespace Plugin
+{
+
+EventBatcher::~EventBatcher()
+{
+    stop();
+}
+
+void EventBatcher::start(uint32_t t_windowMs, uint32_t t_maxCount, FlushHandler&& t_handler)
+{
+    std::lock_guard<std::mutex> lock(m_lock);
+
+    if (m_running)
+    {
+        return;
+    }
+    m_windowMs = t_windowMs;
+    m_maxCount = (0 == t_maxCount) ? 1 : t_maxCount;
+    m_handler = std::move(t_handler);
+    m_pending.reserve(m_maxCount);
+    m_running = true;
+    m_thread = std::thread(&EventBatcher::run, this);
+}
+
+void EventBatcher::stop()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_lock);
+        if (false == m_running)
+        {
+            return;
+        }
+        m_running = false;
+        m_signal.notify_all();
+    }
+    m_thread.join();
+    m_handler = nullptr;
+}
+
+bool EventBatcher::running()
+{
+    std::lock_guard<std::mutex> lock(m_lock);
+    return m_running;
+}
+
+bool EventBatcher::add(std::string t_payload, const std::string& t_source, uint32_t t_sessionId)
+{
+    std::lock_guard<std::mutex> lock(m_lock);
+    if (false == m_running)
+    {
+        return false;
+    }
+
+    const uint64_t timestamp = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+    m_pending.push_back({ std::move(t_payload), t_source, ++m_seq, timestamp, t_sessionId });
+
+    if (m_pending.size() >= m_maxCount)
+    {
+        m_full.push_back(std::move(m_pending));
+        m_pending = std::vector<Entry>();
+        m_pending.reserve(m_maxCount);
+        m_signal.notify_all();
+    }
+    else if (1 == m_pending.size())
+    {
+        m_deadline = Clock::now() + std::chrono::milliseconds(m_windowMs);
+        m_signal.notify_all();
+    }
+    return true;
+}
+
+bool EventBatcher::skip()
+{
+    std::lock_guard<std::mutex> lock(m_lock);
+    if (false == m_running)
+    {
+        return false;
+    }
+    ++m_seq;
+    return true;
+}
+
+void EventBatcher::run()
+{
+    // The only thread calling the handler: full batches were queued before the pending one was started,
+    // so taking them first keeps every batch in seq order.
+    std::unique_lock<std::mutex> lock(m_lock);
+    while (true)
+    {
+        std::vector<Entry> batch;
+        if (false == m_full.empty())
+        {
+            batch = std::move(m_full.front());
+            m_full.pop_front();
+        }
+        else if (m_pending.empty())
+        {
+            if (false == m_running)
+            {
+                break;
+            }
+            m_signal.wait(lock);
+            continue;
+        }
+        else if (m_running && (Clock::now() < m_deadline))
+        {
+            m_signal.wait_until(lock, m_deadline);
+            continue;
+        }
+        else
+        {
+            batch.swap(m_pending);
+            m_pending.reserve(m_maxCount);
+        }
+
+        lock.unlock();
+        m_handler(std::move(batch));
+        lock.lock();
+    }
+}
+
+} // namespace Plugin
+
+} // namespace WPEFramework
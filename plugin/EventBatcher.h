@@ -0,0 +1,123 @@
+/**
+* If not stated otherwise in this file or this component's LICENSE
+* file the following copyright and licenses apply:
+*
+* Copyright 2024 RDK Management
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+**/
+
+#ifndef EVENTBATCHER_H
+#define EVENTBATCHER_H
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace WPEFramework
+{
+
+namespace Plugin
+{
+
+/**
+ * @brief   Collects data events into batches delivered after a time window or once a batch is full.
+ * @details The window starts with the first event of a batch. All batches, full or expired, are
+ *          delivered one at a time on the batcher's own thread, so they arrive in seq order.
+ */
+class EventBatcher
+{
+
+public:
+    struct Entry
+    {
+        std::string payload;
+        std::string source;
+        uint64_t    seq;
+        uint64_t    timestamp; //Milliseconds since the epoch
+        uint32_t    sessionId; //Session that reported the event
+    };
+
+    typedef std::function<void(std::vector<Entry>&&)> FlushHandler;
+
+    EventBatcher() = default;
+    EventBatcher(const EventBatcher&) = delete;
+    EventBatcher& operator=(const EventBatcher&) = delete;
+    ~EventBatcher();
+
+    /**
+     * @brief     This method starts batching.
+     *
+     * @parm[in]  t_windowMs Time from the first event of a batch until it is delivered.
+     * @parm[in]  t_maxCount Number of events delivering a batch before its window expires.
+     * @parm[in]  t_handler  Receives every batch.
+     *
+     * @return    None
+     */
+    void start(uint32_t t_windowMs, uint32_t t_maxCount, FlushHandler&& t_handler);
+
+    /**
+     * @brief     This method delivers the batches still pending and stops batching.
+     *
+     * @return    None
+     */
+    void stop();
+
+    /**
+     * @brief     This method adds an event to the current batch.
+     *
+     * @parm[in]  t_payload   Event payload, moved into the batch.
+     * @parm[in]  t_sessionId Session that reported the event.
+     *
+     * @return    false if batching is not running.
+     */
+    bool add(std::string t_payload, const std::string& t_source, uint32_t t_sessionId = 0);
+
+    /**
+     * @brief     This method leaves an event out of the batches.
+     * @details   The event still takes its seq number, so consumers see the gap.
+     *
+     * @return    false if batching is not running.
+     */
+    bool skip();
+
+    bool running();
+
+private:
+    typedef std::chrono::steady_clock Clock;
+
+    void run();
+
+    std::mutex              m_lock; //Protects everything below
+    std::condition_variable m_signal; //Wakes the batcher thread when a window opens, a batch fills up or on stop
+    std::thread             m_thread;
+    FlushHandler            m_handler;
+    std::vector<Entry>      m_pending;
+    std::deque<std::vector<Entry>> m_full; //Full batches waiting for the batcher thread, oldest first
+    Clock::time_point       m_deadline;
+    uint32_t                m_windowMs = 0;
+    uint32_t                m_maxCount = 0;
+    uint64_t                m_seq = 0;
+    bool                    m_running = false;
+};
+
+} // namespace Plugin
+
+} // namespace WPEFramework
+#endif /* EVENTBATCHER_H */
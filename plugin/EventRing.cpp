@@ -0,0 +1,225 @@
+/**
+* If not stated otherwise in this file or this component's LICENSE
+* file the following copyright and licenses apply:
+*
+* Copyright 2024 RDK Management
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+**/
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <ctime>
+#include <new>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "Module.h"
+#include "EventRing.h"
+#include "UtilsLogging.h"
+
+static_assert(std::atomic<uint64_t>::is_always_lock_free, "EventRing counters must be lock free to live in shared memory");
+
+static constexpr uint32_t RECORD_ALIGNMENT = 8;
+
+static uint32_t alignedLength(std::size_t t_length)
+{
+    return static_cast<uint32_t>((t_length + RECORD_ALIGNMENT - 1) & ~static_cast<std::size_t>(RECORD_ALIGNMENT - 1));
+}
+
+static uint64_t monotonicMicroseconds()
+{
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (static_cast<uint64_t>(now.tv_sec) * 1000000) + (now.tv_nsec / 1000);
+}
+
+// A ring left behind by a previous run of this process's user is replaced; anyone else's object is left alone.
+static bool removeStale(const std::string& t_name)
+{
+    int fd = shm_open(t_name.c_str(), O_RDONLY, 0);
+    if (fd < 0)
+    {
+        return false;
+    }
+    struct stat info;
+    const bool owned = (0 == fstat(fd, &info)) && (geteuid() == info.st_uid);
+    ::close(fd);
+    if (false == owned)
+    {
+        LOGERR("%s exists and belongs to another user", t_name.c_str());
+        errno = EEXIST;
+        return false;
+    }
+    return (0 == shm_unlink(t_name.c_str()));
+}
+
+namespace WPEFramework
+{
+
+namespace Plugin
+{
+
+EventRing::~EventRing()
+{
+    close();
+}
+
+bool EventRing::open(const std::string& t_name, uint32_t t_capacity)
+{
+    std::lock_guard<std::mutex> lock(m_writeLock);
+
+    if (nullptr != m_header)
+    {
+        return true;
+    }
+
+    uint32_t capacity = MIN_CAPACITY;
+    while ((capacity < t_capacity) && (capacity < MAX_CAPACITY))
+    {
+        capacity <<= 1;
+    }
+
+    const std::size_t headerSize = alignedLength(sizeof(Header));
+    const std::size_t mappedSize = headerSize + capacity;
+
+    // Owner only: the ring carries every CAS message, so readers have to run as the plugin's user.
+    int fd = shm_open(t_name.c_str(), O_CREAT | O_EXCL | O_RDWR, S_IRUSR | S_IWUSR);
+    if ((fd < 0) && (EEXIST == errno) && removeStale(t_name))
+    {
+        fd = shm_open(t_name.c_str(), O_CREAT | O_EXCL | O_RDWR, S_IRUSR | S_IWUSR);
+    }
+    if (fd < 0)
+    {
+        LOGERR("shm_open(%s) failed: %s", t_name.c_str(), strerror(errno));
+        return false;
+    }
+
+    if (0 != ftruncate(fd, static_cast<off_t>(mappedSize)))
+    {
+        LOGERR("ftruncate(%s) failed: %s", t_name.c_str(), strerror(errno));
+        ::close(fd);
+        shm_unlink(t_name.c_str());
+        return false;
+    }
+
+    void* base = mmap(nullptr, mappedSize, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (MAP_FAILED == base)
+    {
+        LOGERR("mmap(%s) failed: %s", t_name.c_str(), strerror(errno));
+        shm_unlink(t_name.c_str());
+        return false;
+    }
+
+    m_header = new (base) Header();
+    m_header->magic = MAGIC;
+    m_header->version = VERSION;
+    m_header->headerSize = static_cast<uint16_t>(headerSize);
+    m_header->capacity = capacity;
+    m_header->reserved = 0;
+    m_header->reserveOffset.store(0, std::memory_order_relaxed);
+    m_header->writeOffset.store(0, std::memory_order_relaxed);
+    m_header->sequence.store(0, std::memory_order_relaxed);
+    m_header->dropped.store(0, std::memory_order_release);
+
+    m_data = static_cast<uint8_t*>(base) + headerSize;
+    m_mappedSize = mappedSize;
+    m_name = t_name;
+
+    LOGINFO("Event ring %s created with %u bytes", m_name.c_str(), capacity);
+    return true;
+}
+
+void EventRing::close()
+{
+    std::lock_guard<std::mutex> lock(m_writeLock);
+
+    if (nullptr == m_header)
+    {
+        return;
+    }
+
+    munmap(m_header, m_mappedSize);
+    shm_unlink(m_name.c_str());
+    LOGINFO("Event ring %s removed", m_name.c_str());
+
+    m_header = nullptr;
+    m_data = nullptr;
+    m_mappedSize = 0;
+    m_name.clear();
+}
+
+bool EventRing::write(const std::string& t_payload, const std::string& t_source)
+{
+    std::lock_guard<std::mutex> lock(m_writeLock);
+
+    if (nullptr == m_header)
+    {
+        return false;
+    }
+
+    const uint32_t capacity = m_header->capacity;
+    const uint16_t sourceLength = static_cast<uint16_t>(std::min<std::size_t>(t_source.size(), UINT16_MAX));
+    const uint32_t length = alignedLength(sizeof(Record) + sourceLength + t_payload.size());
+
+    // Larger records would leave readers no chance to consume anything before being lapped.
+    if (length > (capacity / 2))
+    {
+        m_header->dropped.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    uint64_t writeOffset = m_header->writeOffset.load(std::memory_order_relaxed);
+    uint32_t position = static_cast<uint32_t>(writeOffset & (capacity - 1));
+
+    if ((capacity - position) < length)
+    {
+        m_header->reserveOffset.store(writeOffset + (capacity - position), std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+
+        Record* padding = reinterpret_cast<Record*>(m_data + position);
+        padding->length = capacity - position;
+        padding->type = RECORD_PADDING;
+        writeOffset += padding->length;
+        position = 0;
+    }
+
+    // Announce the bytes about to be overwritten before touching them, so readers can detect the overlap.
+    m_header->reserveOffset.store(writeOffset + length, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    Record* record = reinterpret_cast<Record*>(m_data + position);
+    record->length = length;
+    record->type = RECORD_DATA;
+    record->sourceLength = sourceLength;
+    record->sequence = m_header->sequence.load(std::memory_order_relaxed) + 1;
+    record->timestamp = monotonicMicroseconds();
+    record->payloadLength = static_cast<uint32_t>(t_payload.size());
+    record->reserved = 0;
+
+    uint8_t* body = reinterpret_cast<uint8_t*>(record + 1);
+    memcpy(body, t_source.data(), sourceLength);
+    memcpy(body + sourceLength, t_payload.data(), t_payload.size());
+
+    m_header->sequence.store(record->sequence, std::memory_order_relaxed);
+    m_header->writeOffset.store(writeOffset + length, std::memory_order_release);
+    return true;
+}
+
+} // namespace Plugin
+
+} // namespace WPEFramework
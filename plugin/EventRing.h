@@ -0,0 +1,146 @@
+/**
+* If not stated otherwise in this file or this component's LICENSE
+* file the following copyright and licenses apply:
+*
+* Copyright 2024 RDK Management
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+**/
+
+#ifndef EVENTRING_H
+#define EVENTRING_H
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <string>
+
+namespace WPEFramework
+{
+
+namespace Plugin
+{
+
+/**
+ * @brief   Single-writer ring buffer in POSIX shared memory carrying raw CAS event records.
+ * @details The shared object starts with an EventRing::Header followed by the data area.
+ *          Every record starts with an EventRing::Record header, is followed by the source
+ *          and payload bytes and is padded to 8 bytes. A record that does not fit before the
+ *          end of the data area is preceded by a RECORD_PADDING record filling the remainder.
+ *
+ *          Readers map the object read-only and keep their own read offset. A record at
+ *          offset R may be read once Header::writeOffset (acquire) has passed it. After
+ *          consuming it in place the reader issues an acquire fence and loads
+ *          Header::reserveOffset; if reserveOffset - R exceeds capacity the writer has lapped
+ *          the reader, the record must be discarded and the reader resyncs to writeOffset.
+ */
+class EventRing
+{
+
+public:
+    static constexpr uint32_t MAGIC = 0x53414355; //"UCAS"
+    static constexpr uint16_t VERSION = 1;
+    static constexpr uint32_t MIN_CAPACITY = 64 * 1024;
+    static constexpr uint32_t MAX_CAPACITY = 16 * 1024 * 1024;
+
+    enum RecordType : uint16_t
+    {
+        RECORD_PADDING = 0,
+        RECORD_DATA = 1
+    };
+
+    struct Header
+    {
+        uint32_t              magic;
+        uint16_t              version;
+        uint16_t              headerSize; //Offset of the data area from the start of the object
+        uint32_t              capacity; //Size of the data area, a power of two
+        uint32_t              reserved;
+        std::atomic<uint64_t> reserveOffset; //End of the record being written, advanced before its bytes change
+        std::atomic<uint64_t> writeOffset; //Total bytes published, data area offset is writeOffset & (capacity - 1)
+        std::atomic<uint64_t> sequence; //Number of data records published
+        std::atomic<uint64_t> dropped; //Records too large for the ring
+    };
+
+    struct Record
+    {
+        uint32_t length; //Whole record including this header and padding
+        uint16_t type;
+        uint16_t sourceLength;
+        uint64_t sequence;
+        uint64_t timestamp; //Microseconds, CLOCK_MONOTONIC
+        uint32_t payloadLength;
+        uint32_t reserved;
+    };
+
+    EventRing() = default;
+    EventRing(const EventRing&) = delete;
+    EventRing& operator=(const EventRing&) = delete;
+    ~EventRing();
+
+    /**
+     * @brief     This method creates and maps the shared memory object.
+     * @details   The object is readable and writable by the owner only. A stale object of the
+     *            same user is replaced; an object owned by another user makes the call fail.
+     *
+     * @parm[in]  t_name     POSIX shared memory name, starting with '/'.
+     * @parm[in]  t_capacity Requested data area size, rounded up to a power of two.
+     *
+     * @return    true if the ring is ready for writing.
+     */
+    bool open(const std::string& t_name, uint32_t t_capacity);
+
+    /**
+     * @brief     This method unmaps and unlinks the shared memory object.
+     *
+     * @return    None
+     */
+    void close();
+
+    /**
+     * @brief     This method publishes one event record.
+     *
+     * @parm[in]  t_payload Event payload as received from the CAS.
+     * @parm[in]  t_source  Origin of the event.
+     *
+     * @return    false if the ring is closed or the record does not fit.
+     */
+    bool write(const std::string& t_payload, const std::string& t_source);
+
+    bool isOpen() const
+    {
+        return (nullptr != m_header);
+    }
+
+    const std::string& name() const
+    {
+        return m_name;
+    }
+
+    uint32_t capacity() const
+    {
+        return (nullptr != m_header) ? m_header->capacity : 0;
+    }
+
+private:
+    std::mutex  m_writeLock; //Event callbacks may arrive on several threads
+    std::string m_name;
+    Header*     m_header = nullptr;
+    uint8_t*    m_data = nullptr;
+    std::size_t m_mappedSize = 0;
+};
+
+} // namespace Plugin
+
+} // namespace WPEFramework
+#endif /* EVENTRING_H */
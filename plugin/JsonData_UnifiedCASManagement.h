@@ -0,0 +1,186 @@
+/**
+* If not stated otherwise in this file or this component's LICENSE
+* file the following copyright and licenses apply:
+*
+* Copyright 2024 RDK Management
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+**/
+
+// C++ classes for the UnifiedCASManagement JSON-RPC API.
+// Laid out the way JsonGenerator emits them from UnifiedCASManagement.json; keep both in sync.
+// Only the parameters parsed into typed containers have a class here, the other methods take a JsonObject.
+
+#ifndef JSONDATA_UNIFIEDCASMANAGEMENT_H
+#define JSONDATA_UNIFIEDCASMANAGEMENT_H
+
+#include "Module.h"
+#include "ManageMode.h"
+
+namespace WPEFramework
+{
+
+namespace Plugin
+{
+    enum class SessionPriority : uint8_t;
+}
+
+namespace JsonData
+{
+
+namespace UnifiedCASManagement
+{
+
+    // Common enums
+    //
+
+    // The use of the tune request
+    enum class ModeType : uint8_t
+    {
+        MODE_NONE,
+        MODE_LIVE,
+        MODE_RECORD,
+        MODE_PLAYBACK
+    };
+
+    // Claim of the session on the tuner and descrambler
+    enum class PriorityType : uint8_t
+    {
+        PRIORITY_BACKGROUND,
+        PRIORITY_RECORDING,
+        PRIORITY_LIVE
+    };
+
+    // Conversions to and from the scheduler's priority, see JsonEnum_UnifiedCASManagement.cpp
+    Plugin::SessionPriority toSessionPriority(PriorityType t_priority);
+    PriorityType toPriorityType(Plugin::SessionPriority t_priority);
+
+    // Method params/result classes
+    //
+
+    // Enum fields are resolved while parsing: an unknown value leaves the field unset.
+    class ManageParamsData : public Core::JSON::Container
+    {
+    public:
+        ManageParamsData()
+            : Core::JSON::Container()
+        {
+            Add(_T("mediaurl"), &Mediaurl);
+            Add(_T("mode"), &Mode);
+            Add(_T("manage"), &Manage);
+            Add(_T("casinitdata"), &Casinitdata);
+            Add(_T("casocdmid"), &Casocdmid);
+            Add(_T("priority"), &Priority);
+            Add(_T("waittimeout"), &Waittimeout);
+        }
+
+        ManageParamsData(const ManageParamsData&) = delete;
+        ManageParamsData& operator=(const ManageParamsData&) = delete;
+
+    public:
+        Core::JSON::String                           Mediaurl; // The URL to tune to can be tune://, ocap:// http:// https://
+        Core::JSON::EnumType<ModeType>               Mode; // The use of the tune request
+        Core::JSON::EnumType<Plugin::ManageMode>     Manage; // The type of CAS management to attach to the tune
+        Core::JSON::String                           Casinitdata; // CAS specific initdata for the selected media
+        Core::JSON::String                           Casocdmid; // The well-known OCDM ID of the CAS to use
+        Core::JSON::EnumType<PriorityType>           Priority; // Claim of the session on the tuner and descrambler
+        Core::JSON::DecUInt32                        Waittimeout; // Time in ms to queue for a session of the same or higher priority
+    }; // class ManageParamsData
+
+    class SendParamsData : public Core::JSON::Container
+    {
+    public:
+        SendParamsData()
+            : Core::JSON::Container()
+        {
+            Add(_T("payload"), &Payload);
+            Add(_T("source"), &Source);
+            Add(_T("awaitresponse"), &Awaitresponse);
+            Add(_T("timeout"), &Timeout);
+        }
+
+        SendParamsData(const SendParamsData&) = delete;
+        SendParamsData& operator=(const SendParamsData&) = delete;
+
+    public:
+        Core::JSON::String    Payload; // Data to transfer. Can be base64 coded if required
+        Core::JSON::String    Source; // Origin of the data, e.g. PUBLIC or PRIVATE
+        Core::JSON::Boolean   Awaitresponse; // Return the correlated CAS reply as the result
+        Core::JSON::DecUInt32 Timeout; // Time in ms to wait for the reply
+    }; // class SendParamsData
+
+    class SendBeginParamsData : public Core::JSON::Container
+    {
+    public:
+        SendBeginParamsData()
+            : Core::JSON::Container()
+        {
+            Add(_T("size"), &Size);
+            Add(_T("source"), &Source);
+        }
+
+        SendBeginParamsData(const SendBeginParamsData&) = delete;
+        SendBeginParamsData& operator=(const SendBeginParamsData&) = delete;
+
+    public:
+        Core::JSON::DecUInt32 Size; // Size in bytes of the complete payload
+        Core::JSON::String    Source; // Origin of the data, e.g. PUBLIC or PRIVATE
+    }; // class SendBeginParamsData
+
+    class SendChunkParamsData : public Core::JSON::Container
+    {
+    public:
+        SendChunkParamsData()
+            : Core::JSON::Container()
+        {
+            Add(_T("transferid"), &Transferid);
+            Add(_T("offset"), &Offset);
+            Add(_T("data"), &Data);
+        }
+
+        SendChunkParamsData(const SendChunkParamsData&) = delete;
+        SendChunkParamsData& operator=(const SendChunkParamsData&) = delete;
+
+    public:
+        Core::JSON::DecUInt32 Transferid; // Transfer returned by sendBegin
+        Core::JSON::DecUInt32 Offset; // Offset of the chunk in the payload
+        Core::JSON::String    Data; // Next part of the payload
+    }; // class SendChunkParamsData
+
+    class SendEndParamsData : public Core::JSON::Container
+    {
+    public:
+        SendEndParamsData()
+            : Core::JSON::Container()
+        {
+            Add(_T("transferid"), &Transferid);
+        }
+
+        SendEndParamsData(const SendEndParamsData&) = delete;
+        SendEndParamsData& operator=(const SendEndParamsData&) = delete;
+
+    public:
+        Core::JSON::DecUInt32 Transferid; // Transfer returned by sendBegin
+    }; // class SendEndParamsData
+
+} // namespace UnifiedCASManagement
+
+} // namespace JsonData
+
+// Enum conversion handlers
+ENUM_CONVERSION_HANDLER(JsonData::UnifiedCASManagement::ModeType)
+ENUM_CONVERSION_HANDLER(Plugin::ManageMode)
+ENUM_CONVERSION_HANDLER(JsonData::UnifiedCASManagement::PriorityType)
+
+} // namespace WPEFramework
+#endif /* JSONDATA_UNIFIEDCASMANAGEMENT_H */
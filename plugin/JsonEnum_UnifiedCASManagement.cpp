@@ -0,0 +1,72 @@
+/**
+* If not stated otherwise in this file or this component's LICENSE
+* file the following copyright and licenses apply:
+*
+* Copyright 2024 RDK Management
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+**/
+
+// Enumeration code for the UnifiedCASManagement JSON-RPC API, see UnifiedCASManagement.json.
+
+#include "JsonData_UnifiedCASManagement.h"
+#include "SessionScheduler.h"
+
+namespace WPEFramework
+{
+
+ENUM_CONVERSION_BEGIN(JsonData::UnifiedCASManagement::ModeType)
+    { JsonData::UnifiedCASManagement::ModeType::MODE_NONE, _TXT("MODE_NONE") },
+    { JsonData::UnifiedCASManagement::ModeType::MODE_LIVE, _TXT("MODE_LIVE") },
+    { JsonData::UnifiedCASManagement::ModeType::MODE_RECORD, _TXT("MODE_RECORD") },
+    { JsonData::UnifiedCASManagement::ModeType::MODE_PLAYBACK, _TXT("MODE_PLAYBACK") },
+ENUM_CONVERSION_END(JsonData::UnifiedCASManagement::ModeType)
+
+#define UNIFIEDCAS_MANAGE_MODE_CONVERSION(NAME, TUNER) { Plugin::ManageMode::NAME, _TXT(#NAME) },
+ENUM_CONVERSION_BEGIN(Plugin::ManageMode)
+    UNIFIEDCAS_MANAGE_MODES(UNIFIEDCAS_MANAGE_MODE_CONVERSION)
+ENUM_CONVERSION_END(Plugin::ManageMode)
+#undef UNIFIEDCAS_MANAGE_MODE_CONVERSION
+
+ENUM_CONVERSION_BEGIN(JsonData::UnifiedCASManagement::PriorityType)
+    { JsonData::UnifiedCASManagement::PriorityType::PRIORITY_BACKGROUND, _TXT("PRIORITY_BACKGROUND") },
+    { JsonData::UnifiedCASManagement::PriorityType::PRIORITY_RECORDING, _TXT("PRIORITY_RECORDING") },
+    { JsonData::UnifiedCASManagement::PriorityType::PRIORITY_LIVE, _TXT("PRIORITY_LIVE") },
+ENUM_CONVERSION_END(JsonData::UnifiedCASManagement::PriorityType)
+
+namespace JsonData
+{
+
+namespace UnifiedCASManagement
+{
+
+    // The API keeps its own enum so the JSON classes do not depend on the scheduler; both list the priorities lowest first.
+    static_assert(static_cast<uint8_t>(PriorityType::PRIORITY_BACKGROUND) == static_cast<uint8_t>(Plugin::SessionPriority::PRIORITY_BACKGROUND), "PriorityType must match SessionPriority");
+    static_assert(static_cast<uint8_t>(PriorityType::PRIORITY_RECORDING) == static_cast<uint8_t>(Plugin::SessionPriority::PRIORITY_RECORDING), "PriorityType must match SessionPriority");
+    static_assert(static_cast<uint8_t>(PriorityType::PRIORITY_LIVE) == static_cast<uint8_t>(Plugin::SessionPriority::PRIORITY_LIVE), "PriorityType must match SessionPriority");
+
+    Plugin::SessionPriority toSessionPriority(PriorityType t_priority)
+    {
+        return static_cast<Plugin::SessionPriority>(t_priority);
+    }
+
+    PriorityType toPriorityType(Plugin::SessionPriority t_priority)
+    {
+        return static_cast<PriorityType>(t_priority);
+    }
+
+} // namespace UnifiedCASManagement
+
+} // namespace JsonData
+
+} // namespace WPEFramework
@@ -17,10 +17,13 @@
 * limitations under the License.
 **/
 
+#include <mutex>
+#include <type_traits>
+
+#include "Module.h"
 #include "UtilsJsonRpc.h"
 
 #include "LibMediaPlayerImpl.h"
-#include "UnifiedCASManagement.h"
 
 struct kv_pair
 {
@@ -29,13 +32,15 @@ struct kv_pair
 };
 
 // TODO: Need to update/remove the following SOC specific code as and when change is made in MediEngineRMF.cpp
-static kv_pair environment_variables[] = { //Environment variables that need to be set for successful platform initialization.
+static const kv_pair environment_variables[] = { //Environment variables that need to be set for successful platform initialization.
     {"brcm_directfb_mode", "n"},
     {"brcm_multiprocess_server", "refsw_server"},
     {"brcm_multiprocess_mode", "y"},
     {"GST_ENABLE_SVP", "1"}
 };
 
+static std::once_flag environmentSet;
+
 static void setEnvVariables()
 {
     int listSize = sizeof(environment_variables) / sizeof(kv_pair);
@@ -51,7 +56,9 @@ namespace WPEFramework
 namespace Plugin
 {
 
-LibMediaPlayerImpl::LibMediaPlayerImpl(void* t_unifiedCasMgmt) : MediaPlayer(t_unifiedCasMgmt)
+static const std::string SOURCE_PUBLIC = "PUBLIC"; //Origin of the data events libmediaplayer reports
+
+LibMediaPlayerImpl::LibMediaPlayerImpl(MediaPlayerObserver* t_observer) : MediaPlayer(t_observer)
 {
     LOGINFO(" LibMediaPlayerImpl Constructor");
 }
@@ -61,166 +68,241 @@ LibMediaPlayerImpl::~LibMediaPlayerImpl()
     LOGINFO(" LibMediaPlayerImpl Destructor");
 }
 
-bool LibMediaPlayerImpl::openMediaPlayer(
-     std::string&       t_openParams, 
-     const std::string& t_sessionType)
+template <typename POLICY>
+bool LibMediaPlayerSession<POLICY, true>::open(std::string& t_openParams, void* t_userData)
 {
     bool retValue = false;
-    
-    setEnvVariables();
-
-    m_sessionType = t_sessionType;
 
-    if(m_sessionType != "MANAGE_NO_TUNER")
+    if(0 != mediaplayer::initialize(QAM, true, true))
     {
-        if(nullptr != m_libMediaPlayer)
+        LOGERR("Could not initialize QAM support");
+    }
+    else
+    {
+        m_libMediaPlayer = std::unique_ptr <mediaplayer>(mediaplayer::createMediaPlayer(QAM, t_openParams, CAS_TYPE_ANYCAS));
+        if(nullptr == m_libMediaPlayer)
+        {
+            LOGERR("LibMediaPlayer creation failed.");
+        }
+        else
         {
-            LOGERR("LibMediaplayer instance is already avalailable");
-            return retValue;
+            m_libMediaPlayer->registerEventCallbacks(LibMediaPlayerImpl::eventCallBack, LibMediaPlayerImpl::errorCallBack, t_userData);
+            LOGINFO(" Successfully initialized and registered for callbacks with LibMediaPlayer");
+            retValue = true;
         }
+    }
+    return retValue;
+}
+
+template <typename POLICY>
+bool LibMediaPlayerSession<POLICY, true>::close(void)
+{
+    bool retValue = false;
 
-        if(0 != mediaplayer::initialize(QAM, true, true))
+    if(nullptr == m_libMediaPlayer)
+    {
+        LOGERR("LibMediaPlayer instance not found.");
+    }
+    else
+    {
+        if(0 != m_libMediaPlayer->stop())
         {
-            LOGERR("Could not initialize QAM support");
+            LOGERR("Failed to stop libmediaplayer.");
         }
         else
         {
-            m_libMediaPlayer = std::unique_ptr <mediaplayer>(mediaplayer::createMediaPlayer(QAM, t_openParams, CAS_TYPE_ANYCAS));
-            if(nullptr == m_libMediaPlayer)
-            {
-                LOGERR("LibMediaPlayer creation failed.");
-            }
-            else
-            {
-                m_libMediaPlayer->registerEventCallbacks(LibMediaPlayerImpl::eventCallBack, LibMediaPlayerImpl::errorCallBack, this);
-                LOGINFO(" Successfully initialized and registered for callbacks with LibMediaPlayer");
-                retValue = true;
-            }
+            m_libMediaPlayer.reset();
+            retValue = true;
+            LOGERR("libmediaplayer stopped.");
         }
     }
+    return retValue;
+}
+
+template <typename POLICY>
+bool LibMediaPlayerSession<POLICY, true>::requestCASData(std::string& t_data)
+{
+    bool retValue = false;
+
+    if(nullptr == m_libMediaPlayer)
+    {
+        LOGERR("LibMediaPlayer instance not found.");
+    }
     else
     {
-        /* NO_TUNE Management session does not require a tuner or a media pipeline so, creating AnyCasCASService instance directly*/
-        m_anyCasCASServiceInst = std::make_shared <AnyCasCASServiceImpl>(t_openParams);
-        if(nullptr != m_anyCasCASServiceInst)
+        std::weak_ptr<CASService>   tmpPtr = m_libMediaPlayer->getCasServiceInstance();
+        std::shared_ptr<CASService> casService = tmpPtr.lock();
+        AnyCasCASServiceImpl*       anyCasService = nullptr;
+
+        if (nullptr != casService)
         {
-            if(true != m_anyCasCASServiceInst->initializeCasService(nullptr, nullptr))
+            anyCasService = dynamic_cast<AnyCasCASServiceImpl *>(casService.get());
+            if (nullptr != anyCasService)
             {
-                LOGERR("Failed to initialize AnyCasCASServiceImpl.");
+                anyCasService->sendCASData(t_data);
+                LOGINFO(" Successfully sent CASData using sendCASData method");
+                retValue = true;
             }
             else
             {
-                m_anyCasCASServiceInst->registerCallbacks(LibMediaPlayerImpl::eventCallBack, LibMediaPlayerImpl::errorCallBack, this);
-                LOGINFO(" Successfully initialized and registered for callbacks with AnyCasCASServiceImpl");
-                retValue = true;
+                LOGERR("Could not get AnyCasCASServiceImpl instance");
             }
         }
         else
         {
-            LOGERR("Failed to create instance of AnyCasCASServiceImpl.");
+            LOGERR("Could not get CASService instance");
         }
     }
     return retValue;
 }
 
-bool LibMediaPlayerImpl::closeMediaPlayer(void)
+template <typename POLICY>
+bool LibMediaPlayerSession<POLICY, false>::open(std::string& t_openParams, void* t_userData)
 {
     bool retValue = false;
 
-    if(m_sessionType != "MANAGE_NO_TUNER")
+    /* NO_TUNE Management session does not require a tuner or a media pipeline so, creating AnyCasCASService instance directly*/
+    m_anyCasCASServiceInst = std::make_shared <AnyCasCASServiceImpl>(t_openParams);
+    if(nullptr != m_anyCasCASServiceInst)
     {
-        if(nullptr == m_libMediaPlayer)
+        if(true != m_anyCasCASServiceInst->initializeCasService(nullptr, nullptr))
         {
-            LOGERR("LibMediaPlayer instance not found.");
+            LOGERR("Failed to initialize AnyCasCASServiceImpl.");
         }
         else
         {
-            if(0 != m_libMediaPlayer->stop())
-            {
-                LOGERR("Failed to stop libmediaplayer.");
-            }
-            else
-            {
-                m_libMediaPlayer.reset();
-                retValue = true;
-                LOGERR("libmediaplayer stopped.");
-            }
+            m_anyCasCASServiceInst->registerCallbacks(LibMediaPlayerImpl::eventCallBack, LibMediaPlayerImpl::errorCallBack, t_userData);
+            LOGINFO(" Successfully initialized and registered for callbacks with AnyCasCASServiceImpl");
+            retValue = true;
         }
     }
     else
     {
-        if(nullptr != m_anyCasCASServiceInst)
+        LOGERR("Failed to create instance of AnyCasCASServiceImpl.");
+    }
+    return retValue;
+}
+
+template <typename POLICY>
+bool LibMediaPlayerSession<POLICY, false>::close(void)
+{
+    bool retValue = false;
+
+    if(nullptr != m_anyCasCASServiceInst)
+    {
+        if(false == m_anyCasCASServiceInst->stopCasService())
         {
-            if(false == m_anyCasCASServiceInst->stopCasService())
-            {
-                LOGERR("stopCasService failed");
-            }
-            else
-            {
-                m_anyCasCASServiceInst.reset();
-                m_sessionType.clear();
-                retValue = true;
-                LOGERR("stopCasService success.");
-            }
+            LOGERR("stopCasService failed");
         }
         else
         {
-            LOGERR("AnyCasCASServiceImpl instance not found");
+            m_anyCasCASServiceInst.reset();
+            retValue = true;
+            LOGERR("stopCasService success.");
         }
     }
+    else
+    {
+        LOGERR("AnyCasCASServiceImpl instance not found");
+    }
     return retValue;
 }
 
-bool LibMediaPlayerImpl::requestCASData(std::string& t_data)
+template <typename POLICY>
+bool LibMediaPlayerSession<POLICY, false>::requestCASData(std::string& t_data)
 {
     bool retValue = false;
 
-    if(m_sessionType != "MANAGE_NO_TUNER")
+    if(nullptr != m_anyCasCASServiceInst)
     {
-        if(nullptr == m_libMediaPlayer)
+        m_anyCasCASServiceInst->sendCASData(t_data);
+        LOGINFO(" Successfully sent CASData using sendCASData method");
+        retValue = true;
+    }
+    else
+    {
+        LOGERR("AnyCasCASServiceImpl instance not found");
+    }
+    return retValue;
+}
+
+template <typename POLICY>
+bool LibMediaPlayerImpl::openSession(std::string& t_openParams)
+{
+    LibMediaPlayerSession<POLICY>& session = m_session.emplace<LibMediaPlayerSession<POLICY>>();
+    if (false == session.open(t_openParams, this))
+    {
+        m_session.emplace<std::monostate>();
+        return false;
+    }
+    return true;
+}
+
+bool LibMediaPlayerImpl::openMediaPlayer(
+     std::string&       t_openParams, 
+     ManageMode         t_sessionType)
+{
+    bool retValue = false;
+    
+    if(false == std::holds_alternative<std::monostate>(m_session))
+    {
+        LOGERR("LibMediaplayer session is already avalailable");
+        return retValue;
+    }
+
+    // The environment is process-wide; setenv racing a getenv of another instance's open is undefined.
+    std::call_once(environmentSet, setEnvVariables);
+
+    // The mode is resolved here once; every later call dispatches on the session's policy type.
+    switch(t_sessionType)
+    {
+        case ManageMode::MANAGE_FULL:
+            retValue = openSession<ManageFullPolicy>(t_openParams);
+            break;
+        case ManageMode::MANAGE_NO_PSI:
+            retValue = openSession<ManageNoPsiPolicy>(t_openParams);
+            break;
+        case ManageMode::MANAGE_NO_TUNER:
+            retValue = openSession<ManageNoTunerPolicy>(t_openParams);
+            break;
+    }
+    return retValue;
+}
+
+bool LibMediaPlayerImpl::closeMediaPlayer(void)
+{
+    bool retValue = std::visit([](auto& session) -> bool {
+        if constexpr (std::is_same_v<std::decay_t<decltype(session)>, std::monostate>)
         {
-            LOGERR("LibMediaPlayer instance not found.");
+            LOGERR("LibMediaPlayer session not found.");
+            return false;
         }
         else
         {
-            std::weak_ptr<CASService>   tmpPtr = m_libMediaPlayer->getCasServiceInstance();
-            std::shared_ptr<CASService> casService = tmpPtr.lock();
-            AnyCasCASServiceImpl*       anyCasService = nullptr;
-
-            if (nullptr != casService)
-            {
-                anyCasService = dynamic_cast<AnyCasCASServiceImpl *>(casService.get());
-                if (nullptr != anyCasService)
-                {
-                    anyCasService->sendCASData(t_data);
-                    LOGINFO(" Successfully sent CASData using sendCASData method");
-                    retValue = true;
-                }
-                else
-                {
-                    LOGERR("Could not get AnyCasCASServiceImpl instance");
-                }
-            }
-            else
-            {
-                LOGERR("Could not get CASService instance");
-            }
+            return session.close();
         }
-    }
-    else
+    }, m_session);
+
+    if(retValue)
     {
-        if(nullptr != m_anyCasCASServiceInst)
+        m_session.emplace<std::monostate>();
+    }
+    return retValue;
+}
+
+bool LibMediaPlayerImpl::requestCASData(std::string& t_data)
+{
+    return std::visit([&t_data](auto& session) -> bool {
+        if constexpr (std::is_same_v<std::decay_t<decltype(session)>, std::monostate>)
         {
-            m_anyCasCASServiceInst->sendCASData(t_data);
-            LOGINFO(" Successfully sent CASData using sendCASData method");
-            retValue = true;
+            LOGERR("LibMediaPlayer session not found.");
+            return false;
         }
         else
         {
-            LOGERR("AnyCasCASServiceImpl instance not found");
+            return session.requestCASData(t_data);
         }
-    }
-    return retValue;
+    }, m_session);
 }
 
 void LibMediaPlayerImpl::eventCallBack(
@@ -230,9 +312,17 @@ void LibMediaPlayerImpl::eventCallBack(
     LibMediaPlayerImpl * instance = reinterpret_cast<LibMediaPlayerImpl *>(t_data);
     if(nullptr != instance)
     {
-        UnifiedCASManagement * session = reinterpret_cast<UnifiedCASManagement *>(instance->m_unifiedCasMgmt);
+        MediaPlayerObserver * observer = instance->m_observer.load();
         LOGINFO("Received mediaPlayerEvent. casData is %s", t_payload->m_message.c_str());
-        session->event_data(t_payload->m_message, "PUBLIC");
+        if(nullptr != observer)
+        {
+            // libmediaplayer keeps ownership of the payload, so its message is copied once here and moved from then on.
+            observer->onPlayerData(std::string(t_payload->m_message), SOURCE_PUBLIC, instance->sessionId());
+        }
+        else
+        {
+            LOGWARN("Session is closed, dropping mediaPlayerEvent");
+        }
     }
     else
     {
@@ -247,7 +337,12 @@ void LibMediaPlayerImpl::errorCallBack(
     LibMediaPlayerImpl * instance = reinterpret_cast<LibMediaPlayerImpl *>(t_data);
     if(nullptr != instance)
     {
+        MediaPlayerObserver * observer = instance->m_observer.load();
         LOGINFO("Received mediaPlayerError. status is %lld", t_payload->m_code);
+        if(nullptr != observer)
+        {
+            observer->onPlayerError(t_payload->m_code, instance->sessionId());
+        }
     }
     else
     {
@@ -258,3 +353,14 @@ void LibMediaPlayerImpl::errorCallBack(
 } // namespace Plugin
 
 } // namespace WPEFramework
+
+// Entry points resolved by LibMediaPlayerModule when this library is loaded.
+extern "C" WPEFramework::Plugin::MediaPlayer* unifiedCasCreateLibMediaPlayer(WPEFramework::Plugin::MediaPlayerObserver* t_observer)
+{
+    return new WPEFramework::Plugin::LibMediaPlayerImpl(t_observer);
+}
+
+extern "C" void unifiedCasDestroyLibMediaPlayer(WPEFramework::Plugin::MediaPlayer* t_player)
+{
+    delete t_player;
+}
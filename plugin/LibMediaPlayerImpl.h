@@ -23,6 +23,7 @@
 #include "MediaPlayer.h"
 #include "libmediaplayer.h"
 #include <memory>
+#include <variant>
 
 using namespace libmediaplayer;
 
@@ -32,6 +33,39 @@ namespace WPEFramework
 namespace Plugin
 {
 
+/**
+ * @brief   Management session backed by libmediaplayer, specialized on whether POLICY needs a tuner.
+ * @details Tuned sessions (MANAGE_FULL, MANAGE_NO_PSI) run a QAM media player and reach the CAS
+ *          service through it. MANAGE_NO_TUNER sessions need neither a tuner nor a media
+ *          pipeline and drive an AnyCasCASServiceImpl directly.
+ */
+template <typename POLICY, bool TUNED = POLICY::usesTuner>
+class LibMediaPlayerSession;
+
+template <typename POLICY>
+class LibMediaPlayerSession<POLICY, true>
+{
+public:
+    bool open(std::string& t_openParams, void* t_userData);
+    bool close(void);
+    bool requestCASData(std::string& t_data);
+
+private:
+    std::unique_ptr <libmediaplayer::mediaplayer> m_libMediaPlayer = nullptr; //To store the libmediaplayer instance
+};
+
+template <typename POLICY>
+class LibMediaPlayerSession<POLICY, false>
+{
+public:
+    bool open(std::string& t_openParams, void* t_userData);
+    bool close(void);
+    bool requestCASData(std::string& t_data);
+
+private:
+    std::shared_ptr <AnyCasCASServiceImpl> m_anyCasCASServiceInst = nullptr; //To store AnyCasCASServiceImpl instance
+};
+
 /**
  * @brief   This class will implement MediaPlayer APIs to support/enable
  *          its functionalities to work with libmediaplayer.
@@ -43,7 +77,7 @@ class LibMediaPlayerImpl: public MediaPlayer
 public:
     LibMediaPlayerImpl() = delete;
 
-    LibMediaPlayerImpl(void* t_unifiedCasMgmt);
+    LibMediaPlayerImpl(MediaPlayerObserver* t_observer);
 
     virtual ~LibMediaPlayerImpl();
 
@@ -59,7 +93,7 @@ public:
      */
     virtual bool openMediaPlayer(
                  std::string&       t_openParams, 
-                 const std::string& t_sessionType) override;
+                 ManageMode         t_sessionType) override;
 
     /**
      * @brief     This method destroys libmediaplayer.
@@ -80,6 +114,9 @@ public:
     virtual bool requestCASData(std::string& t_data) override;
 
 private:
+    template <typename POLICY, bool TUNED>
+    friend class LibMediaPlayerSession;
+
     /**
      * @brief     This method is used to register with mediaplayer(libmediaplayer) to get 
      *            the status notifications.
@@ -106,9 +143,15 @@ private:
                 notification_payload * t_payload,
                 void *                 t_data);
 
-    std::unique_ptr <libmediaplayer::mediaplayer> m_libMediaPlayer = nullptr; //To store the libmediaplayer instance
-    std::shared_ptr <AnyCasCASServiceImpl>        m_anyCasCASServiceInst = nullptr; //To store AnyCasCASServiceImpl instance
-    std::string                                   m_sessionType = "";//To store the type of management session
+    template <typename POLICY>
+    bool openSession(std::string& t_openParams);
+
+    typedef std::variant<std::monostate,
+                         LibMediaPlayerSession<ManageFullPolicy>,
+                         LibMediaPlayerSession<ManageNoPsiPolicy>,
+                         LibMediaPlayerSession<ManageNoTunerPolicy>> Session;
+
+    Session m_session; //Active management session, its alternative fixes the type of management session
 };
 
 } // namespace Plugin
@@ -0,0 +1,288 @@
+/**
+* If not stated otherwise in this file or this component's LICENSE
+* file the following copyright and licenses apply:
+*
+* Copyright 2024 RDK Management
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+**/
+
+
+#include <chrono>
+#include <dlfcn.h>
+
+#include "Module.h"
+#include "LibMediaPlayerModule.h"
+#include "UtilsLogging.h"
+
+#ifndef LMPLAYER_MODULE
+#define LMPLAYER_MODULE "libWPEFrameworkUnifiedCASManagementLibMediaPlayer.so"
+#endif
+
+namespace WPEFramework
+{
+
+namespace Plugin
+{
+
+LibMediaPlayerModule::LibMediaPlayerModule(const std::string& t_path)
+    : m_path(t_path)
+{
+}
+
+LibMediaPlayerModule::~LibMediaPlayerModule()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_lock);
+        m_stopping = true;
+    }
+    m_signal.notify_all();
+    if (m_reaper.joinable())
+    {
+        m_reaper.join();
+    }
+    std::lock_guard<std::mutex> lock(m_lock);
+    unloadLocked();
+}
+
+std::string LibMediaPlayerModule::defaultPath()
+{
+    // The module is installed next to the plugin library, which dlopen would not search on its own.
+    Dl_info info;
+    if ((0 != dladdr(reinterpret_cast<void*>(&LibMediaPlayerModule::defaultPath), &info)) && (nullptr != info.dli_fname))
+    {
+        std::string path(info.dli_fname);
+        std::size_t slash = path.rfind('/');
+        if (std::string::npos != slash)
+        {
+            return path.substr(0, slash + 1) + LMPLAYER_MODULE;
+        }
+    }
+    return LMPLAYER_MODULE;
+}
+
+void LibMediaPlayerModule::setUnloadDelay(uint32_t t_delayMs)
+{
+    {
+        std::lock_guard<std::mutex> lock(m_lock);
+        m_unloadDelayMs = t_delayMs;
+        if (nullptr != m_handle)
+        {
+            startReaperLocked();
+        }
+    }
+    m_signal.notify_all();
+}
+
+MediaPlayer* LibMediaPlayerModule::create(MediaPlayerObserver* t_observer)
+{
+    std::lock_guard<std::mutex> lock(m_lock);
+
+    if ((nullptr == m_handle) && (false == loadLocked()))
+    {
+        return nullptr;
+    }
+    MediaPlayer* player = m_table.create(t_observer);
+    if (nullptr != player)
+    {
+        ++m_players;
+    }
+    return player;
+}
+
+void LibMediaPlayerModule::destroy(MediaPlayer* t_player)
+{
+    {
+        std::lock_guard<std::mutex> lock(m_lock);
+        m_table.destroy(t_player);
+        --m_players;
+    }
+    m_signal.notify_all();
+}
+
+bool LibMediaPlayerModule::loaded()
+{
+    std::lock_guard<std::mutex> lock(m_lock);
+    return (nullptr != m_handle);
+}
+
+bool LibMediaPlayerModule::loadLocked()
+{
+    const auto started = std::chrono::steady_clock::now();
+    void* handle = dlopen(m_path.c_str(), RTLD_NOW | RTLD_LOCAL);
+    if (nullptr == handle)
+    {
+        LOGERR("Failed to load %s: %s", m_path.c_str(), dlerror());
+        return false;
+    }
+
+    FunctionTable table;
+    table.create = reinterpret_cast<MediaPlayer* (*)(MediaPlayerObserver*)>(dlsym(handle, "unifiedCasCreateLibMediaPlayer"));
+    table.destroy = reinterpret_cast<void (*)(MediaPlayer*)>(dlsym(handle, "unifiedCasDestroyLibMediaPlayer"));
+    if ((nullptr == table.create) || (nullptr == table.destroy))
+    {
+        LOGERR("%s does not export the player entry points", m_path.c_str());
+        dlclose(handle);
+        return false;
+    }
+
+    m_handle = handle;
+    m_table = table;
+    ++m_loads;
+    m_loadTimeMs = static_cast<uint32_t>(std::chrono::duration_cast<std::chrono::milliseconds>(
+                       std::chrono::steady_clock::now() - started).count());
+    LOGINFO("Loaded %s in %u ms", m_path.c_str(), m_loadTimeMs.load());
+
+    startReaperLocked();
+    return true;
+}
+
+void LibMediaPlayerModule::startReaperLocked()
+{
+    // Without a delay the module is never unloaded, so no thread is needed until one is set.
+    if ((0 != m_unloadDelayMs) && (false == m_reaper.joinable()))
+    {
+        m_reaper = std::thread(&LibMediaPlayerModule::reap, this);
+    }
+}
+
+void LibMediaPlayerModule::unloadLocked()
+{
+    if (nullptr != m_handle)
+    {
+        dlclose(m_handle);
+        m_handle = nullptr;
+        m_table = { nullptr, nullptr };
+        ++m_unloads;
+        LOGINFO("Unloaded %s", m_path.c_str());
+    }
+}
+
+void LibMediaPlayerModule::reap()
+{
+    std::unique_lock<std::mutex> lock(m_lock);
+    while (false == m_stopping)
+    {
+        m_signal.wait(lock, [this] { return m_stopping || ((nullptr != m_handle) && (0 == m_players) && (0 != m_unloadDelayMs)); });
+        if (m_stopping)
+        {
+            break;
+        }
+        // A player created or a delay changed during the wait restarts it.
+        const uint32_t delayMs = m_unloadDelayMs;
+        if (false == m_signal.wait_for(lock, std::chrono::milliseconds(delayMs),
+                                       [this, delayMs] { return m_stopping || (0 != m_players) || (delayMs != m_unloadDelayMs); }))
+        {
+            unloadLocked();
+        }
+    }
+}
+
+LibMediaPlayerProxy::LibMediaPlayerProxy(MediaPlayerObserver* t_observer, std::shared_ptr<LibMediaPlayerModule> t_module)
+    : MediaPlayer(t_observer)
+    , m_module(std::move(t_module))
+{
+}
+
+LibMediaPlayerProxy::~LibMediaPlayerProxy()
+{
+    std::lock_guard<std::mutex> lock(m_lock);
+    releaseLocked();
+}
+
+bool LibMediaPlayerProxy::openMediaPlayer(std::string& t_openParams, ManageMode t_sessionType)
+{
+    std::lock_guard<std::mutex> lock(m_lock);
+
+    if (nullptr == m_player)
+    {
+        m_player = m_module->create(m_observer.load());
+        if (nullptr == m_player)
+        {
+            return false;
+        }
+        m_player->setSessionId(sessionId());
+    }
+    if (false == m_player->openMediaPlayer(t_openParams, t_sessionType))
+    {
+        releaseLocked();
+        return false;
+    }
+    return true;
+}
+
+bool LibMediaPlayerProxy::closeMediaPlayer(void)
+{
+    std::lock_guard<std::mutex> lock(m_lock);
+
+    if (nullptr == m_player)
+    {
+        LOGERR("LibMediaPlayer session not found.");
+        return false;
+    }
+    if (false == m_player->closeMediaPlayer())
+    {
+        // Still open natively, so the implementation is kept for the close to be retried.
+        return false;
+    }
+    // The implementation goes with the session, so an idle service does not keep the module loaded.
+    releaseLocked();
+    return true;
+}
+
+bool LibMediaPlayerProxy::requestCASData(std::string& t_data)
+{
+    std::lock_guard<std::mutex> lock(m_lock);
+
+    if (nullptr == m_player)
+    {
+        LOGERR("LibMediaPlayer session not found.");
+        return false;
+    }
+    return m_player->requestCASData(t_data);
+}
+
+void LibMediaPlayerProxy::detachService(void)
+{
+    MediaPlayer::detachService();
+
+    std::lock_guard<std::mutex> lock(m_lock);
+    if (nullptr != m_player)
+    {
+        m_player->detachService();
+    }
+}
+
+void LibMediaPlayerProxy::setSessionId(uint32_t t_sessionId)
+{
+    MediaPlayer::setSessionId(t_sessionId);
+
+    std::lock_guard<std::mutex> lock(m_lock);
+    if (nullptr != m_player)
+    {
+        m_player->setSessionId(t_sessionId);
+    }
+}
+
+void LibMediaPlayerProxy::releaseLocked()
+{
+    if (nullptr != m_player)
+    {
+        m_module->destroy(m_player);
+        m_player = nullptr;
+    }
+}
+
+} // namespace Plugin
+
+} // namespace WPEFramework
@@ -0,0 +1,163 @@
+/**
+* If not stated otherwise in this file or this component's LICENSE
+* file the following copyright and licenses apply:
+*
+* Copyright 2024 RDK Management
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+**/
+
+
+#ifndef LIBMEDIAPLAYERMODULE_H
+#define LIBMEDIAPLAYERMODULE_H
+
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include "MediaPlayer.h"
+
+namespace WPEFramework
+{
+
+namespace Plugin
+{
+
+/**
+ * @brief   The libmediaplayer backend, loaded with dlopen while sessions use it.
+ * @details LibMediaPlayerImpl and the media stack it links are built into a module of their own.
+ *          The module is loaded when the first player is created, so activation doesn't pay for the
+ *          stack. If an idle delay is set, it is unloaded again once no player has used it for that
+ *          long; this is off by default as not every media stack survives dlclose.
+ *          Players are created and destroyed through the C entry points resolved at load time.
+ */
+class LibMediaPlayerModule
+{
+
+public:
+    static constexpr const char* BACKEND_NAME = "libmediaplayer"; //Name in the player backend configuration
+
+    /**
+     * @brief Entry points exported by the module with C linkage.
+     */
+    struct FunctionTable
+    {
+        MediaPlayer* (*create)(MediaPlayerObserver* t_observer);
+        void         (*destroy)(MediaPlayer* t_player);
+    };
+
+    explicit LibMediaPlayerModule(const std::string& t_path);
+    ~LibMediaPlayerModule();
+
+    LibMediaPlayerModule() = delete;
+    LibMediaPlayerModule(const LibMediaPlayerModule&) = delete;
+    LibMediaPlayerModule& operator=(const LibMediaPlayerModule&) = delete;
+
+    /**
+     * @brief     This method returns the path of the module installed next to the plugin library.
+     */
+    static std::string defaultPath();
+
+    /**
+     * @brief     This method sets how long the module stays loaded without players, 0 to keep it loaded.
+     *
+     * @return    None
+     */
+    void setUnloadDelay(uint32_t t_delayMs);
+
+    /**
+     * @brief     This method creates a LibMediaPlayerImpl, loading the module first if needed.
+     *
+     * @return    New player, or nullptr if the module could not be loaded.
+     */
+    MediaPlayer* create(MediaPlayerObserver* t_observer);
+
+    /**
+     * @brief     This method destroys a player returned by create().
+     *
+     * @return    None
+     */
+    void destroy(MediaPlayer* t_player);
+
+    bool loaded();
+
+    uint32_t loads() const
+    {
+        return m_loads.load(std::memory_order_relaxed);
+    }
+
+    uint32_t unloads() const
+    {
+        return m_unloads.load(std::memory_order_relaxed);
+    }
+
+    uint32_t loadTimeMs() const
+    {
+        return m_loadTimeMs.load(std::memory_order_relaxed);
+    }
+
+private:
+    bool loadLocked();
+    void unloadLocked();
+    void startReaperLocked();
+    void reap();
+
+    const std::string       m_path;
+    std::mutex              m_lock; //Protects the state below
+    std::condition_variable m_signal; //Signalled when the player count drops to zero or on shutdown
+    std::thread             m_reaper; //Unloads the module after the idle delay, started once a delay is set
+    void*                   m_handle = nullptr;
+    FunctionTable           m_table = { nullptr, nullptr };
+    uint32_t                m_players = 0; //Players created and not yet destroyed
+    uint32_t                m_unloadDelayMs = 0; //Unloading is opt-in, 0 keeps the module once loaded
+    bool                    m_stopping = false;
+    std::atomic<uint32_t>   m_loads { 0 };
+    std::atomic<uint32_t>   m_unloads { 0 };
+    std::atomic<uint32_t>   m_loadTimeMs { 0 }; //Time the last dlopen took
+};
+
+/**
+ * @brief   Player of the libmediaplayer backend, holding a LibMediaPlayerImpl only while a session is open.
+ */
+class LibMediaPlayerProxy : public MediaPlayer
+{
+
+public:
+    LibMediaPlayerProxy(MediaPlayerObserver* t_observer, std::shared_ptr<LibMediaPlayerModule> t_module);
+    virtual ~LibMediaPlayerProxy();
+
+    LibMediaPlayerProxy() = delete;
+    LibMediaPlayerProxy(const LibMediaPlayerProxy&) = delete;
+    LibMediaPlayerProxy& operator=(const LibMediaPlayerProxy&) = delete;
+
+    bool openMediaPlayer(std::string& t_openParams, ManageMode t_sessionType) override;
+    bool closeMediaPlayer(void) override;
+    bool requestCASData(std::string& t_data) override;
+    void detachService(void) override;
+    void setSessionId(uint32_t t_sessionId) override;
+
+private:
+    void releaseLocked();
+
+    std::shared_ptr<LibMediaPlayerModule> m_module; //Kept alive by players outliving the service
+    std::mutex                            m_lock; //Protects m_player
+    MediaPlayer*                          m_player = nullptr; //Implementation of the open session
+};
+
+} // namespace Plugin
+
+} // namespace WPEFramework
+
+#endif /* LIBMEDIAPLAYERMODULE_H */
@@ -0,0 +1,101 @@
+/**
+* If not stated otherwise in this file or this component's LICENSE
+* file the following copyright and licenses apply:
+*
+* Copyright 2024 RDK Management
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+**/
+
+#ifndef MANAGEMODE_H
+#define MANAGEMODE_H
+
+#include <cstdint>
+#include <string_view>
+
+namespace WPEFramework
+{
+
+namespace Plugin
+{
+
+/**
+ * @brief The management modes with whether they hold a tuner, in ManageMode order.
+ * @details The only list of the modes: ManageMode, MANAGE_MODES and the JSON enum conversion
+ *          in JsonEnum_UnifiedCASManagement.cpp are all expanded from it.
+ */
+#define UNIFIEDCAS_MANAGE_MODES(MODE) \
+    MODE(MANAGE_FULL,     true)  \
+    MODE(MANAGE_NO_PSI,   true)  \
+    MODE(MANAGE_NO_TUNER, false)
+
+/**
+ * @brief Type of CAS management attached to a session, parsed once from the "manage" parameter.
+ */
+enum class ManageMode : uint8_t
+{
+#define UNIFIEDCAS_MANAGE_MODE_ENUM(NAME, TUNER) NAME,
+    UNIFIEDCAS_MANAGE_MODES(UNIFIEDCAS_MANAGE_MODE_ENUM)
+#undef UNIFIEDCAS_MANAGE_MODE_ENUM
+};
+
+struct ManageModeEntry
+{
+    std::string_view name;
+    ManageMode       mode;
+    bool             usesTuner;
+};
+
+static constexpr ManageModeEntry MANAGE_MODES[] = {
+#define UNIFIEDCAS_MANAGE_MODE_ENTRY(NAME, TUNER) { #NAME, ManageMode::NAME, TUNER },
+    UNIFIEDCAS_MANAGE_MODES(UNIFIEDCAS_MANAGE_MODE_ENTRY)
+#undef UNIFIEDCAS_MANAGE_MODE_ENTRY
+};
+
+constexpr bool manageModeValid(uint8_t t_value)
+{
+    return (t_value < (sizeof(MANAGE_MODES) / sizeof(MANAGE_MODES[0])));
+}
+
+constexpr const ManageModeEntry& manageModeEntry(ManageMode t_mode)
+{
+    return MANAGE_MODES[static_cast<uint8_t>(t_mode)];
+}
+
+constexpr bool usesTuner(ManageMode t_mode)
+{
+    return manageModeEntry(t_mode).usesTuner;
+}
+
+static_assert(manageModeEntry(ManageMode::MANAGE_FULL).mode == ManageMode::MANAGE_FULL, "MANAGE_MODES must be indexed by ManageMode");
+static_assert(manageModeEntry(ManageMode::MANAGE_NO_PSI).mode == ManageMode::MANAGE_NO_PSI, "MANAGE_MODES must be indexed by ManageMode");
+static_assert(manageModeEntry(ManageMode::MANAGE_NO_TUNER).mode == ManageMode::MANAGE_NO_TUNER, "MANAGE_MODES must be indexed by ManageMode");
+
+/**
+ * @brief Compile-time session policies, one per ManageMode.
+ */
+template <ManageMode MODE>
+struct ManagePolicy
+{
+    static constexpr ManageMode mode = MODE;
+    static constexpr bool       usesTuner = Plugin::usesTuner(MODE);
+};
+
+typedef ManagePolicy<ManageMode::MANAGE_FULL>     ManageFullPolicy;
+typedef ManagePolicy<ManageMode::MANAGE_NO_PSI>   ManageNoPsiPolicy;
+typedef ManagePolicy<ManageMode::MANAGE_NO_TUNER> ManageNoTunerPolicy;
+
+} // namespace Plugin
+
+} // namespace WPEFramework
+#endif /* MANAGEMODE_H */
@@ -20,8 +20,10 @@
 #ifndef MEDIAPLAYER_H
 #define MEDIAPLAYER_H
 
+#include <atomic>
 #include <iostream>
 #include <string>
+#include "ManageMode.h"
 
 using namespace std;
 
@@ -31,15 +33,48 @@ namespace WPEFramework
 namespace Plugin
 {
 
+/**
+ * @brief   Receiver of the notifications of a MediaPlayer, implemented by the UnifiedCASManagement service.
+ * @details Called on the player's callback threads.
+ */
+class MediaPlayerObserver
+{
+
+public:
+    virtual ~MediaPlayerObserver() = default;
+
+    /**
+     * @brief     This method receives data sent by the CAS.
+     *
+     * @parm[in]  t_payload   CAS message; ownership passes to the observer.
+     * @parm[in]  t_source    Origin of the message.
+     * @parm[in]  t_sessionId Session served by the reporting player.
+     *
+     * @return    None
+     */
+    virtual void onPlayerData(std::string&& t_payload, const std::string& t_source, uint32_t t_sessionId) = 0;
+
+    /**
+     * @brief     This method receives an error reported by the player.
+     *
+     * @parm[in]  t_code      Error code reported by the player.
+     * @parm[in]  t_sessionId Session served by the reporting player.
+     *
+     * @return    None
+     */
+    virtual void onPlayerError(int64_t t_code, uint32_t t_sessionId) = 0;
+};
+
 class MediaPlayer
 {
 
 public:
     MediaPlayer() = delete;
 
-    MediaPlayer(void* t_unifiedCasMgmt)
+    MediaPlayer(MediaPlayerObserver* t_observer)
     {
-        m_unifiedCasMgmt = t_unifiedCasMgmt;
+        m_observer = t_observer;
+        m_sessionId = 0;
     }
 
     virtual ~MediaPlayer()
@@ -58,7 +93,7 @@ public:
      */
     virtual bool openMediaPlayer(
                  std::string&       t_openParams, 
-                 const std::string& t_sessionType)
+                 ManageMode         t_sessionType)
     {
         return true;
     }
@@ -87,8 +122,38 @@ public:
         return true;
     }
 
+    /**
+     * @brief     This method stops notifications from this player reaching the UnifiedCASManagement service.
+     * @details   Used when a session is handed over for teardown and may outlive the service.
+     *
+     * @return    None
+     */
+    virtual void detachService(void)
+    {
+        m_observer = nullptr;
+    }
+
+    /**
+     * @brief     This method sets the identifier of the session this player serves.
+     * @details   The identifier is attached to every notification the player forwards.
+     *
+     * @parm[in]  t_sessionId Session identifier assigned by the UnifiedCASManagement service.
+     *
+     * @return    None
+     */
+    virtual void setSessionId(uint32_t t_sessionId)
+    {
+        m_sessionId = t_sessionId;
+    }
+
+    uint32_t sessionId(void) const
+    {
+        return m_sessionId;
+    }
+
 protected:
-    void* m_unifiedCasMgmt; //Instance of UnifiedCASManagement service
+    std::atomic<MediaPlayerObserver*> m_observer; //Instance of UnifiedCASManagement service
+    std::atomic<uint32_t>             m_sessionId; //Session served by this player
 };
 
 } // namespace Plugin
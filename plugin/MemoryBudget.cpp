@@ -0,0 +1,107 @@
+/**
+* If not stated otherwise in this file or this component's LICENSE
+* file the following copyright and licenses apply:
+*
+* Copyright 2024 RDK Management
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+**/
+
+
+#include "MemoryBudget.h"
+
+namespace WPEFramework
+{
+
+namespace Plugin
+{
+
+void MemoryBudget::configure(std::size_t t_softLimit, std::size_t t_hardLimit)
+{
+    m_softLimit = t_softLimit;
+    m_hardLimit = t_hardLimit;
+}
+
+void MemoryBudget::charge(uint32_t t_sessionId, Category t_category, std::size_t t_bytes)
+{
+    if (0 == t_bytes)
+    {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(m_lock);
+    adjustLocked(t_sessionId, t_category, m_sessions[t_sessionId][t_category] + t_bytes);
+}
+
+void MemoryBudget::release(uint32_t t_sessionId, Category t_category, std::size_t t_bytes)
+{
+    if (0 == t_bytes)
+    {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(m_lock);
+    const std::size_t charged = m_sessions[t_sessionId][t_category];
+    adjustLocked(t_sessionId, t_category, (charged > t_bytes) ? (charged - t_bytes) : 0);
+}
+
+void MemoryBudget::set(uint32_t t_sessionId, Category t_category, std::size_t t_bytes)
+{
+    std::lock_guard<std::mutex> lock(m_lock);
+    adjustLocked(t_sessionId, t_category, t_bytes);
+}
+
+std::vector<MemoryBudget::SessionUsage> MemoryBudget::usage()
+{
+    std::vector<SessionUsage> result;
+    std::lock_guard<std::mutex> lock(m_lock);
+    result.reserve(m_sessions.size());
+    for (const auto& session : m_sessions)
+    {
+        SessionUsage entry;
+        entry.sessionId = session.first;
+        entry.total = 0;
+        for (uint8_t category = 0; category < CATEGORY_COUNT; ++category)
+        {
+            entry.bytes[category] = session.second[category];
+            entry.total += session.second[category];
+        }
+        result.push_back(entry);
+    }
+    return result;
+}
+
+void MemoryBudget::adjustLocked(uint32_t t_sessionId, Category t_category, std::size_t t_bytes)
+{
+    // operator[] value-initializes the counters of a session seen for the first time.
+    Counters& session = m_sessions[t_sessionId];
+    const std::size_t used = m_used.load(std::memory_order_relaxed) - session[t_category] + t_bytes;
+    session[t_category] = t_bytes;
+    m_used.store(used, std::memory_order_relaxed);
+    if (used > m_peak.load(std::memory_order_relaxed))
+    {
+        m_peak.store(used, std::memory_order_relaxed);
+    }
+
+    bool empty = true;
+    for (std::size_t bytes : session)
+    {
+        empty = empty && (0 == bytes);
+    }
+    if (empty)
+    {
+        m_sessions.erase(t_sessionId);
+    }
+}
+
+} // namespace Plugin
+
+} // namespace WPEFramework
@@ -0,0 +1,177 @@
+/**
+* If not stated otherwise in this file or this component's LICENSE
+* file the following copyright and licenses apply:
+*
+* Copyright 2024 RDK Management
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+**/
+
+
+#ifndef MEMORYBUDGET_H
+#define MEMORYBUDGET_H
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <vector>
+
+namespace WPEFramework
+{
+
+namespace Plugin
+{
+
+/**
+ * @brief   Accounting of the memory the plugin holds per session, checked against a soft and a hard cap.
+ * @details Usage is charged by category under the session it serves; memory not tied to a session,
+ *          such as chunked uploads owned by a client connection, is charged under SHARED_SESSION.
+ *          Player instances are charged with a configured footprint since their native allocations
+ *          cannot be measured from the plugin. A cap of 0 is disabled. The level is read lock-free
+ *          on the hot paths deciding whether to shed load. The response and PSI caches, the event
+ *          ring and the traffic log are not charged: they are bounded by their own configuration
+ *          and shedding load would not shrink them, so charging them could only pin the level.
+ */
+class MemoryBudget
+{
+
+public:
+    static constexpr uint32_t SHARED_SESSION = 0;
+
+    enum Category : uint8_t
+    {
+        CATEGORY_PLAYER = 0, //Player instance of an open session
+        CATEGORY_TRANSFERS, //Buffers reserved by chunked uploads
+        CATEGORY_REQUESTS, //Request frames and awaited replies of sends in progress
+        CATEGORY_EVENTS, //Data events queued for the databatch event
+        CATEGORY_COUNT
+    };
+
+    enum Level : uint8_t
+    {
+        LEVEL_NORMAL = 0,
+        LEVEL_SOFT, //Load is shed: events are not batched and chunked uploads are refused
+        LEVEL_HARD //New sessions are refused as well
+    };
+
+    struct SessionUsage
+    {
+        uint32_t    sessionId;
+        std::size_t bytes[CATEGORY_COUNT];
+        std::size_t total;
+    };
+
+    /**
+     * @brief   Charge released when it goes out of scope, for memory held while a call executes.
+     */
+    class Charge
+    {
+    public:
+        Charge() = delete;
+        Charge(const Charge&) = delete;
+        Charge& operator=(const Charge&) = delete;
+
+        Charge(MemoryBudget& t_budget, uint32_t t_sessionId, Category t_category, std::size_t t_bytes)
+            : m_budget(t_budget)
+            , m_sessionId(t_sessionId)
+            , m_category(t_category)
+            , m_bytes(t_bytes)
+        {
+            m_budget.charge(m_sessionId, m_category, m_bytes);
+        }
+
+        ~Charge()
+        {
+            m_budget.release(m_sessionId, m_category, m_bytes);
+        }
+
+    private:
+        MemoryBudget&     m_budget;
+        const uint32_t    m_sessionId;
+        const Category    m_category;
+        const std::size_t m_bytes;
+    };
+
+    MemoryBudget() = default;
+    MemoryBudget(const MemoryBudget&) = delete;
+    MemoryBudget& operator=(const MemoryBudget&) = delete;
+
+    /**
+     * @brief     This method sets the caps. Usage charged so far is kept.
+     *
+     * @parm[in]  t_softLimit Bytes from which load is shed, 0 disables it.
+     * @parm[in]  t_hardLimit Bytes from which new sessions are refused, 0 disables it.
+     *
+     * @return    None
+     */
+    void configure(std::size_t t_softLimit, std::size_t t_hardLimit);
+
+    void charge(uint32_t t_sessionId, Category t_category, std::size_t t_bytes);
+    void release(uint32_t t_sessionId, Category t_category, std::size_t t_bytes);
+
+    /**
+     * @brief     This method replaces the usage of a session in one category, e.g. when a gauge is re-read.
+     *
+     * @return    None
+     */
+    void set(uint32_t t_sessionId, Category t_category, std::size_t t_bytes);
+
+    Level level() const
+    {
+        const std::size_t used = m_used.load(std::memory_order_relaxed);
+        const std::size_t hardLimit = m_hardLimit.load(std::memory_order_relaxed);
+        const std::size_t softLimit = m_softLimit.load(std::memory_order_relaxed);
+        if ((0 != hardLimit) && (used >= hardLimit))
+        {
+            return LEVEL_HARD;
+        }
+        return ((0 != softLimit) && (used >= softLimit)) ? LEVEL_SOFT : LEVEL_NORMAL;
+    }
+
+    std::vector<SessionUsage> usage();
+
+    std::size_t used() const { return m_used.load(); }
+    std::size_t peak() const { return m_peak.load(); }
+    std::size_t softLimit() const { return m_softLimit.load(); }
+    std::size_t hardLimit() const { return m_hardLimit.load(); }
+
+    void countEventShed() { ++m_eventsShed; }
+    void countTransferRejected() { ++m_transfersRejected; }
+    void countSessionRefused() { ++m_sessionsRefused; }
+    uint32_t eventsShed() const { return m_eventsShed.load(); }
+    uint32_t transfersRejected() const { return m_transfersRejected.load(); }
+    uint32_t sessionsRefused() const { return m_sessionsRefused.load(); }
+
+private:
+    void adjustLocked(uint32_t t_sessionId, Category t_category, std::size_t t_bytes);
+
+    typedef std::array<std::size_t, CATEGORY_COUNT> Counters;
+
+    std::mutex                   m_lock; //Protects m_sessions
+    std::map<uint32_t, Counters> m_sessions; //Sessions with memory charged, in bytes per category
+    std::atomic<std::size_t>     m_used { 0 };
+    std::atomic<std::size_t>     m_peak { 0 };
+    std::atomic<std::size_t>     m_softLimit { 0 };
+    std::atomic<std::size_t>     m_hardLimit { 0 };
+    std::atomic<uint32_t>        m_eventsShed { 0 };
+    std::atomic<uint32_t>        m_transfersRejected { 0 };
+    std::atomic<uint32_t>        m_sessionsRefused { 0 };
+};
+
+} // namespace Plugin
+
+} // namespace WPEFramework
+#endif /* MEMORYBUDGET_H */
@@ -0,0 +1,142 @@
+/**
+* If not stated otherwise in this file or this component's LICENSE
+* file the following copyright and licenses apply:
+*
+* Copyright 2024 RDK Management
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+**/
+
+
+#include <cstring>
+
+#include "OutboundJson.h"
+
+namespace WPEFramework
+{
+
+namespace Plugin
+{
+
+static const char HEX_DIGITS[] = "0123456789abcdef";
+
+std::string OutboundJson::serialize(const Field* t_fields, std::size_t t_count)
+{
+    // Braces and separating commas, plus per field the quoted label and a colon.
+    std::size_t size = 2 + ((0 != t_count) ? (t_count - 1) : 0);
+    for (std::size_t index = 0; index < t_count; ++index)
+    {
+        const Field& field = t_fields[index];
+        size += strlen(field.label) + 3;
+        size += field.isText ? (escapedSize(field.text) + 2) : digits(field.number);
+    }
+
+    std::string out;
+    out.reserve(size);
+    out += '{';
+    for (std::size_t index = 0; index < t_count; ++index)
+    {
+        const Field& field = t_fields[index];
+        if (0 != index)
+        {
+            out += ',';
+        }
+        out += '"';
+        out += field.label;
+        out += "\":";
+        if (field.isText)
+        {
+            out += '"';
+            appendEscaped(out, field.text);
+            out += '"';
+        }
+        else
+        {
+            char buffer[10];
+            char* begin = buffer + sizeof(buffer);
+            uint32_t number = field.number;
+            do
+            {
+                *--begin = static_cast<char>('0' + (number % 10));
+                number /= 10;
+            } while (0 != number);
+            out.append(begin, buffer + sizeof(buffer));
+        }
+    }
+    out += '}';
+    return out;
+}
+
+std::size_t OutboundJson::escapedSize(std::string_view t_text)
+{
+    std::size_t size = t_text.size();
+    for (const char character : t_text)
+    {
+        const unsigned char code = static_cast<unsigned char>(character);
+        if (('"' == character) || ('\\' == character) || ('\b' == character) || ('\f' == character) ||
+            ('\n' == character) || ('\r' == character) || ('\t' == character))
+        {
+            size += 1;
+        }
+        else if (code < 0x20)
+        {
+            size += 5;
+        }
+    }
+    return size;
+}
+
+void OutboundJson::appendEscaped(std::string& t_out, std::string_view t_text)
+{
+    for (const char character : t_text)
+    {
+        const unsigned char code = static_cast<unsigned char>(character);
+        switch (character)
+        {
+            case '"':  t_out += "\\\""; break;
+            case '\\': t_out += "\\\\"; break;
+            case '\b': t_out += "\\b"; break;
+            case '\f': t_out += "\\f"; break;
+            case '\n': t_out += "\\n"; break;
+            case '\r': t_out += "\\r"; break;
+            case '\t': t_out += "\\t"; break;
+            default:
+                if (code < 0x20)
+                {
+                    t_out += "\\u00";
+                    t_out += HEX_DIGITS[code >> 4];
+                    t_out += HEX_DIGITS[code & 0x0F];
+                }
+                else
+                {
+                    t_out += character;
+                }
+                break;
+        }
+    }
+}
+
+std::size_t OutboundJson::digits(uint32_t t_number)
+{
+    std::size_t count = 1;
+    while (t_number >= 10)
+    {
+        t_number /= 10;
+        ++count;
+    }
+    return count;
+}
+
+} // namespace Plugin
+
+} // namespace WPEFramework
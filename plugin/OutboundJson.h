@@ -0,0 +1,123 @@
+/**
+* If not stated otherwise in this file or this component's LICENSE
+* file the following copyright and licenses apply:
+*
+* Copyright 2024 RDK Management
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+**/
+
+
+#ifndef OUTBOUNDJSON_H
+#define OUTBOUNDJSON_H
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+namespace WPEFramework
+{
+
+namespace Plugin
+{
+
+/**
+ * @brief   Serializer for the flat JSON objects handed to the MediaPlayer and to data event subscribers.
+ * @details The object is measured first and written into a string of exactly that size, so a
+ *          request costs one allocation instead of the JsonObject nodes, labels and value copies
+ *          a JsonObject round-trip makes. Fields are written in the order given.
+ */
+class OutboundJson
+{
+
+public:
+    struct Field
+    {
+        Field(const char* t_label, std::string_view t_text)
+            : label(t_label)
+            , text(t_text)
+            , number(0)
+            , isText(true)
+        {
+        }
+
+        Field(const char* t_label, uint32_t t_number)
+            : label(t_label)
+            , text()
+            , number(t_number)
+            , isText(false)
+        {
+        }
+
+        const char*      label; //Plain ASCII label, written as is
+        std::string_view text; //String value, escaped
+        uint32_t         number;
+        bool             isText;
+    };
+
+    /**
+     * @brief     This method serializes fields into a JSON object.
+     *
+     * @parm[in]  t_fields Fields to write.
+     * @parm[in]  t_count  Number of fields.
+     *
+     * @return    The JSON text.
+     */
+    static std::string serialize(const Field* t_fields, std::size_t t_count);
+
+    /**
+     * @brief   Serialized text passed to Notify in place of a JsonObject.
+     * @details Notify only asks its parameters for ToString(), which hands the text over unchanged.
+     */
+    class Text
+    {
+    public:
+        explicit Text(const std::string& t_text)
+            : m_text(t_text)
+        {
+        }
+
+        void ToString(std::string& t_text) const
+        {
+            t_text = m_text;
+        }
+
+    private:
+        const std::string& m_text;
+    };
+
+    /**
+     * @brief     This method returns the size of a string value once escaped, without quotes.
+     */
+    static std::size_t escapedSize(std::string_view t_text);
+
+    /**
+     * @brief     This method appends a string value escaped, without quotes.
+     *
+     * @parm[out] t_out  String to append to.
+     * @parm[in]  t_text Value to escape.
+     *
+     * @return    None
+     */
+    static void appendEscaped(std::string& t_out, std::string_view t_text);
+
+private:
+    static std::size_t digits(uint32_t t_number);
+};
+
+} // namespace Plugin
+
+} // namespace WPEFramework
+
+#endif /* OUTBOUNDJSON_H */
@@ -0,0 +1,54 @@
+/**
+* If not stated otherwise in this file or this component's LICENSE
+* file the following copyright and licenses apply:
+*
+* Copyright 2024 RDK Management
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+**/
+
+
+#include "Module.h"
+#include "PlayerRegistry.h"
+#include "UtilsLogging.h"
+
+namespace WPEFramework
+{
+
+namespace Plugin
+{
+
+bool PlayerRegistry::add(const std::string& t_name, Factory&& t_factory)
+{
+    return m_factories.emplace(t_name, std::move(t_factory)).second;
+}
+
+bool PlayerRegistry::contains(const std::string& t_name) const
+{
+    return (m_factories.end() != m_factories.find(t_name));
+}
+
+std::shared_ptr<MediaPlayer> PlayerRegistry::create(const std::string& t_name, MediaPlayerObserver* t_observer) const
+{
+    std::map<std::string, Factory>::const_iterator factory = m_factories.find(t_name);
+    if (m_factories.end() == factory)
+    {
+        LOGERR("Player backend '%s' is not available", t_name.c_str());
+        return nullptr;
+    }
+    return factory->second(t_observer);
+}
+
+} // namespace Plugin
+
+} // namespace WPEFramework
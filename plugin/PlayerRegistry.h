@@ -0,0 +1,81 @@
+/**
+* If not stated otherwise in this file or this component's LICENSE
+* file the following copyright and licenses apply:
+*
+* Copyright 2024 RDK Management
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+**/
+
+
+#ifndef PLAYERREGISTRY_H
+#define PLAYERREGISTRY_H
+
+#include <functional>
+#include <map>
+#include <memory>
+#include <string>
+#include "MediaPlayer.h"
+
+namespace WPEFramework
+{
+
+namespace Plugin
+{
+
+/**
+ * @brief   Named MediaPlayer backends available to the UnifiedCASManagement service.
+ * @details Backends are registered with a factory when the service is constructed; the
+ *          configuration then picks one by name per manage mode.
+ */
+class PlayerRegistry
+{
+
+public:
+    typedef std::function<std::shared_ptr<MediaPlayer>(MediaPlayerObserver* t_observer)> Factory;
+
+    PlayerRegistry() = default;
+    PlayerRegistry(const PlayerRegistry&) = delete;
+    PlayerRegistry& operator=(const PlayerRegistry&) = delete;
+
+    /**
+     * @brief     This method registers a backend.
+     *
+     * @parm[in]  t_name    Name the configuration refers to the backend by.
+     * @parm[in]  t_factory Creates a player of the backend.
+     *
+     * @return    false if a backend of that name is already registered.
+     */
+    bool add(const std::string& t_name, Factory&& t_factory);
+
+    bool contains(const std::string& t_name) const;
+
+    /**
+     * @brief     This method creates a player of a backend.
+     *
+     * @parm[in]  t_name     Name of the backend.
+     * @parm[in]  t_observer Service the player reports to.
+     *
+     * @return    New player, or nullptr if no such backend is registered.
+     */
+    std::shared_ptr<MediaPlayer> create(const std::string& t_name, MediaPlayerObserver* t_observer) const;
+
+private:
+    std::map<std::string, Factory> m_factories;
+};
+
+} // namespace Plugin
+
+} // namespace WPEFramework
+
+#endif /* PLAYERREGISTRY_H */
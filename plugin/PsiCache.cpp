@@ -0,0 +1,169 @@
+/**
+* If not stated otherwise in this file or this component's LICENSE
+* file the following copyright and licenses apply:
+*
+* Copyright 2024 RDK Management
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+**/
+
+
+#include "Module.h"
+#include "PsiCache.h"
+#include "UtilsLogging.h"
+
+namespace WPEFramework
+{
+
+namespace Plugin
+{
+
+void PsiCache::configure(uint32_t t_capacity, std::string&& t_prefix)
+{
+    std::lock_guard<std::mutex> lock(m_lock);
+    m_capacity = t_capacity;
+    m_prefix = std::move(t_prefix);
+    m_lru.clear();
+    m_index.clear();
+    m_sessionUrl.clear();
+    m_enabled = (0 != m_capacity) && (false == m_prefix.empty());
+}
+
+bool PsiCache::open(uint32_t t_sessionId, const std::string& t_mediaurl, Entry& t_entry)
+{
+    if ((false == enabled()) || t_mediaurl.empty())
+    {
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(m_lock);
+    m_sessionId = t_sessionId;
+    m_sessionUrl = t_mediaurl;
+    m_sessionOpened = Clock::now();
+    m_sessionReported = false;
+    m_sessionConfirmed = false;
+    m_sessionHit = false;
+    m_sessionSavedMs = 0;
+
+    auto found = m_index.find(t_mediaurl);
+    if (m_index.end() == found)
+    {
+        return false;
+    }
+    m_lru.splice(m_lru.begin(), m_lru, found->second);
+    t_entry = found->second->second;
+    m_sessionHit = true;
+    m_sessionSavedMs = t_entry.acquisitionMs;
+    return true;
+}
+
+void PsiCache::confirm(uint32_t t_sessionId)
+{
+    if (false == enabled())
+    {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(m_lock);
+    if (m_sessionConfirmed || (t_sessionId != m_sessionId))
+    {
+        return;
+    }
+    m_sessionConfirmed = true;
+    if (false == m_sessionHit)
+    {
+        ++m_misses;
+        return;
+    }
+    ++m_hits;
+    // The stack no longer waits for the PSI, so the time it took to acquire it last is saved.
+    m_timeSavedMs += m_sessionSavedMs;
+    m_lastTimeSavedMs = m_sessionSavedMs;
+}
+
+bool PsiCache::report(uint32_t t_sessionId, const std::string& t_payload)
+{
+    if (false == enabled())
+    {
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(m_lock);
+    if ((0 != t_payload.compare(0, m_prefix.size(), m_prefix)) || (t_sessionId != m_sessionId) || m_sessionUrl.empty())
+    {
+        return false;
+    }
+
+    JsonObject report;
+    if ((false == report.FromString(t_payload)) || (false == report.HasLabel("psi")) || (false == report.HasLabel("version")))
+    {
+        LOGWARN("Ignoring malformed PSI report");
+        return false;
+    }
+
+    const uint32_t version = static_cast<uint32_t>(report["version"].Number());
+    uint32_t acquisitionMs = 0;
+    if (false == m_sessionReported)
+    {
+        acquisitionMs = static_cast<uint32_t>(std::chrono::duration_cast<std::chrono::milliseconds>(
+                            Clock::now() - m_sessionOpened).count());
+        m_sessionReported = true;
+    }
+
+    auto found = m_index.find(m_sessionUrl);
+    if (m_index.end() != found)
+    {
+        Entry& entry = found->second->second;
+        m_lru.splice(m_lru.begin(), m_lru, found->second);
+        if (entry.version == version)
+        {
+            // Same version: the cached descriptors were valid, keep the acquisition time measured on the miss.
+            return true;
+        }
+        LOGINFO("PSI of %s changed from version %u to %u", m_sessionUrl.c_str(), entry.version, version);
+        ++m_invalidations;
+        entry.psi = report["psi"].String();
+        entry.version = version;
+        if (0 != acquisitionMs)
+        {
+            entry.acquisitionMs = acquisitionMs;
+        }
+        return true;
+    }
+
+    m_lru.push_front({ m_sessionUrl, { report["psi"].String(), version, acquisitionMs } });
+    m_index[m_sessionUrl] = m_lru.begin();
+    while (m_lru.size() > m_capacity)
+    {
+        m_index.erase(m_lru.back().first);
+        m_lru.pop_back();
+    }
+    return true;
+}
+
+void PsiCache::clear()
+{
+    std::lock_guard<std::mutex> lock(m_lock);
+    m_lru.clear();
+    m_index.clear();
+}
+
+uint32_t PsiCache::size()
+{
+    std::lock_guard<std::mutex> lock(m_lock);
+    return static_cast<uint32_t>(m_lru.size());
+}
+
+} // namespace Plugin
+
+} // namespace WPEFramework
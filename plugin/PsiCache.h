@@ -0,0 +1,163 @@
+/**
+* If not stated otherwise in this file or this component's LICENSE
+* file the following copyright and licenses apply:
+*
+* Copyright 2024 RDK Management
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+**/
+
+
+#ifndef PSICACHE_H
+#define PSICACHE_H
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <list>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+namespace WPEFramework
+{
+
+namespace Plugin
+{
+
+/**
+ * @brief   LRU cache of the PSI and CA descriptors reported for each media URL.
+ * @details MANAGE_FULL sessions report the PAT/PMT and CA descriptors they acquired as a data event
+ *          starting with the configured prefix and carrying "psi" and "version". The last report per
+ *          media URL is kept and handed to the next session tuning that URL, so the stack can start
+ *          descrambling before fresh PSI arrives. A report with another version replaces the entry.
+ *          The cache is disabled while its capacity is 0.
+ */
+class PsiCache
+{
+
+public:
+    struct Entry
+    {
+        std::string psi; //PSI and CA descriptors as reported by the stack
+        uint32_t    version = 0; //Version number of the PSI
+        uint32_t    acquisitionMs = 0; //Time the stack took to report it after the session opened
+    };
+
+    PsiCache() = default;
+    PsiCache(const PsiCache&) = delete;
+    PsiCache& operator=(const PsiCache&) = delete;
+
+    /**
+     * @brief     This method sets the number of media URLs kept and drops all entries.
+     *
+     * @parm[in]  t_capacity Entries kept, 0 disables the cache.
+     * @parm[in]  t_prefix   Leading bytes of the data events reporting PSI.
+     *
+     * @return    None
+     */
+    void configure(uint32_t t_capacity, std::string&& t_prefix);
+
+    /**
+     * @brief     This method starts tracking the PSI reports of a session and looks up its media URL.
+     * @details   The lookup is only counted once confirm() reports the session opened.
+     *
+     * @parm[in]  t_sessionId Session being opened.
+     * @parm[in]  t_mediaurl  Media URL the session tunes to.
+     * @parm[out] t_entry     Cached PSI of that URL.
+     *
+     * @return    true on a hit.
+     */
+    bool open(uint32_t t_sessionId, const std::string& t_mediaurl, Entry& t_entry);
+
+    /**
+     * @brief     This method counts the lookup of a session that opened, as a hit with its time saved or as a miss.
+     *
+     * @parm[in]  t_sessionId Session passed to open().
+     *
+     * @return    None
+     */
+    void confirm(uint32_t t_sessionId);
+
+    /**
+     * @brief     This method stores a PSI report of the session opened last.
+     *
+     * @parm[in]  t_sessionId Session the data event came from.
+     * @parm[in]  t_payload   Payload of the data event.
+     *
+     * @return    true if the payload was a PSI report and was stored.
+     */
+    bool report(uint32_t t_sessionId, const std::string& t_payload);
+
+    void clear();
+
+    bool enabled() const
+    {
+        return m_enabled.load(std::memory_order_relaxed);
+    }
+
+    uint64_t hits() const
+    {
+        return m_hits.load(std::memory_order_relaxed);
+    }
+
+    uint64_t misses() const
+    {
+        return m_misses.load(std::memory_order_relaxed);
+    }
+
+    uint64_t invalidations() const
+    {
+        return m_invalidations.load(std::memory_order_relaxed);
+    }
+
+    uint64_t timeSavedMs() const
+    {
+        return m_timeSavedMs.load(std::memory_order_relaxed);
+    }
+
+    uint32_t lastTimeSavedMs() const
+    {
+        return m_lastTimeSavedMs.load(std::memory_order_relaxed);
+    }
+
+    uint32_t size();
+
+private:
+    typedef std::chrono::steady_clock Clock;
+    typedef std::list<std::pair<std::string, Entry>> Lru;
+
+    std::mutex                                        m_lock; //Protects the entries and the tracked session
+    Lru                                               m_lru; //Most recently used first
+    std::unordered_map<std::string, Lru::iterator>    m_index;
+    uint32_t                                          m_capacity = 0;
+    std::string                                       m_prefix;
+    uint32_t                                          m_sessionId = 0; //Session whose reports are stored
+    std::string                                       m_sessionUrl;
+    Clock::time_point                                 m_sessionOpened;
+    bool                                              m_sessionReported = false; //True once that session reported PSI
+    bool                                              m_sessionConfirmed = true; //True once the lookup of that session is counted
+    bool                                              m_sessionHit = false;
+    uint32_t                                          m_sessionSavedMs = 0; //Acquisition time of the PSI handed to that session
+    std::atomic<bool>                                 m_enabled { false }; //Lets callers skip the lock while disabled
+    std::atomic<uint64_t>                             m_hits { 0 };
+    std::atomic<uint64_t>                             m_misses { 0 };
+    std::atomic<uint64_t>                             m_invalidations { 0 };
+    std::atomic<uint64_t>                             m_timeSavedMs { 0 };
+    std::atomic<uint32_t>                             m_lastTimeSavedMs { 0 };
+};
+
+} // namespace Plugin
+
+} // namespace WPEFramework
+#endif /* PSICACHE_H */
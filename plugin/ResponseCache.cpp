@@ -0,0 +1,175 @@
+/**
+* If not stated otherwise in this file or this component's LICENSE
+* file the following copyright and licenses apply:
+*
+* Copyright 2024 RDK Management
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+**/
+
+#include <algorithm>
+
+#include "Module.h"
+#include "ResponseCache.h"
+#include "UtilsLogging.h"
+
+static bool startsWith(const std::string& t_text, const std::string& t_prefix)
+{
+    return (0 == t_text.compare(0, t_prefix.size(), t_prefix));
+}
+
+namespace WPEFramework
+{
+
+namespace Plugin
+{
+
+void ResponseCache::configure(std::vector<Rule>&& t_rules, std::vector<std::string>&& t_flushOn)
+{
+    std::lock_guard<std::mutex> lock(m_lock);
+
+    // Rules without a TTL would never hit, drop them up front.
+    t_rules.erase(std::remove_if(t_rules.begin(), t_rules.end(), [](const Rule& rule) { return 0 == rule.ttlMs; }), t_rules.end());
+
+    m_rules = std::move(t_rules);
+    m_flushOn = std::move(t_flushOn);
+    m_entries.clear();
+    m_enabled.store(false == m_rules.empty(), std::memory_order_relaxed);
+
+    for (const Rule& rule : m_rules)
+    {
+        LOGINFO("Caching replies to \"%s\" for %u ms", rule.prefix.c_str(), rule.ttlMs);
+    }
+}
+
+bool ResponseCache::lookup(const std::string& t_payload, const std::string& t_source, uint32_t t_sessionId,
+                           std::string& t_reply, std::string& t_replySource)
+{
+    if (false == enabled())
+    {
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(m_lock);
+    if (nullptr == findRule(t_payload))
+    {
+        return false;
+    }
+
+    std::unordered_map<std::size_t, Entry>::iterator entry = m_entries.find(key(t_payload, t_source, t_sessionId));
+    if ((m_entries.end() != entry) && (entry->second.expiry <= Clock::now()))
+    {
+        m_entries.erase(entry);
+        entry = m_entries.end();
+    }
+
+    if ((m_entries.end() == entry) ||
+        (entry->second.sessionId != t_sessionId) || (entry->second.source != t_source) || (entry->second.payload != t_payload))
+    {
+        m_misses.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    t_reply = entry->second.reply;
+    t_replySource = entry->second.replySource;
+    m_hits.fetch_add(1, std::memory_order_relaxed);
+    return true;
+}
+
+void ResponseCache::store(const std::string& t_payload, const std::string& t_source, uint32_t t_sessionId,
+                          const std::string& t_reply, const std::string& t_replySource)
+{
+    if (false == enabled())
+    {
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(m_lock);
+    const Rule* rule = findRule(t_payload);
+    if (nullptr == rule)
+    {
+        return;
+    }
+
+    const Clock::time_point now = Clock::now();
+    if (m_entries.size() >= MAX_ENTRIES)
+    {
+        for (std::unordered_map<std::size_t, Entry>::iterator entry = m_entries.begin(); entry != m_entries.end();)
+        {
+            entry = (entry->second.expiry <= now) ? m_entries.erase(entry) : std::next(entry);
+        }
+        if (m_entries.size() >= MAX_ENTRIES)
+        {
+            m_entries.clear();
+        }
+    }
+
+    m_entries[key(t_payload, t_source, t_sessionId)] =
+        Entry { t_payload, t_source, t_sessionId, t_reply, t_replySource, now + std::chrono::milliseconds(rule->ttlMs) };
+}
+
+bool ResponseCache::flushOn(const std::string& t_payload)
+{
+    if (false == enabled())
+    {
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(m_lock);
+    for (const std::string& prefix : m_flushOn)
+    {
+        if (startsWith(t_payload, prefix))
+        {
+            m_entries.clear();
+            m_flushes.fetch_add(1, std::memory_order_relaxed);
+            return true;
+        }
+    }
+    return false;
+}
+
+void ResponseCache::flush()
+{
+    std::lock_guard<std::mutex> lock(m_lock);
+    m_entries.clear();
+}
+
+uint32_t ResponseCache::size()
+{
+    std::lock_guard<std::mutex> lock(m_lock);
+    return static_cast<uint32_t>(m_entries.size());
+}
+
+const ResponseCache::Rule* ResponseCache::findRule(const std::string& t_payload) const
+{
+    for (const Rule& rule : m_rules)
+    {
+        if (startsWith(t_payload, rule.prefix))
+        {
+            return &rule;
+        }
+    }
+    return nullptr;
+}
+
+std::size_t ResponseCache::key(const std::string& t_payload, const std::string& t_source, uint32_t t_sessionId)
+{
+    std::size_t seed = std::hash<std::string>{}(t_payload);
+    seed ^= std::hash<std::string>{}(t_source) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+    seed ^= std::hash<uint32_t>{}(t_sessionId) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+    return seed;
+}
+
+} // namespace Plugin
+
+} // namespace WPEFramework
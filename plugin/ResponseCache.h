@@ -0,0 +1,153 @@
+/**
+* If not stated otherwise in this file or this component's LICENSE
+* file the following copyright and licenses apply:
+*
+* Copyright 2024 RDK Management
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+**/
+
+#ifndef RESPONSECACHE_H
+#define RESPONSECACHE_H
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace WPEFramework
+{
+
+namespace Plugin
+{
+
+/**
+ * @brief   Time-limited cache of CAS replies to awaited send requests.
+ * @details Entries are keyed by a hash of the request payload, source and session. Only payloads
+ *          starting with a configured query prefix are cached, each prefix with its own TTL.
+ *          The cache is disabled while no rule is configured.
+ */
+class ResponseCache
+{
+
+public:
+    static constexpr uint32_t MAX_ENTRIES = 256;
+
+    struct Rule
+    {
+        std::string prefix; //Leading bytes of the request payload identifying the query type
+        uint32_t    ttlMs;
+    };
+
+    ResponseCache() = default;
+    ResponseCache(const ResponseCache&) = delete;
+    ResponseCache& operator=(const ResponseCache&) = delete;
+
+    /**
+     * @brief     This method replaces the caching rules and drops all entries.
+     *
+     * @parm[in]  t_rules   Query types to cache, the first matching prefix wins.
+     * @parm[in]  t_flushOn Data event prefixes signalling an entitlement change.
+     *
+     * @return    None
+     */
+    void configure(std::vector<Rule>&& t_rules, std::vector<std::string>&& t_flushOn);
+
+    /**
+     * @brief     This method looks up a cached reply.
+     *
+     * @parm[in]  t_payload     Request payload.
+     * @parm[in]  t_source      Request source.
+     * @parm[in]  t_sessionId   Session the request was sent to.
+     * @parm[out] t_reply       Cached reply payload.
+     * @parm[out] t_replySource Cached reply source.
+     *
+     * @return    true on a hit. Requests no rule applies to are neither hits nor misses.
+     */
+    bool lookup(const std::string& t_payload, const std::string& t_source, uint32_t t_sessionId,
+                std::string& t_reply, std::string& t_replySource);
+
+    /**
+     * @brief     This method stores a reply if a rule applies to the request.
+     *
+     * @return    None
+     */
+    void store(const std::string& t_payload, const std::string& t_source, uint32_t t_sessionId,
+               const std::string& t_reply, const std::string& t_replySource);
+
+    /**
+     * @brief     This method drops all entries if a data event signals an entitlement change.
+     *
+     * @parm[in]  t_payload Payload of the data event.
+     *
+     * @return    true if the cache was flushed.
+     */
+    bool flushOn(const std::string& t_payload);
+
+    void flush();
+
+    bool enabled() const
+    {
+        return m_enabled.load(std::memory_order_relaxed);
+    }
+
+    uint64_t hits() const
+    {
+        return m_hits.load(std::memory_order_relaxed);
+    }
+
+    uint64_t misses() const
+    {
+        return m_misses.load(std::memory_order_relaxed);
+    }
+
+    uint64_t flushes() const
+    {
+        return m_flushes.load(std::memory_order_relaxed);
+    }
+
+    uint32_t size();
+
+private:
+    typedef std::chrono::steady_clock Clock;
+
+    struct Entry
+    {
+        std::string       payload; //Kept to tell hash collisions apart
+        std::string       source;
+        uint32_t          sessionId;
+        std::string       reply;
+        std::string       replySource;
+        Clock::time_point expiry;
+    };
+
+    const Rule* findRule(const std::string& t_payload) const;
+    static std::size_t key(const std::string& t_payload, const std::string& t_source, uint32_t t_sessionId);
+
+    std::mutex                             m_lock; //Protects the rules and entries
+    std::vector<Rule>                      m_rules;
+    std::vector<std::string>               m_flushOn;
+    std::unordered_map<std::size_t, Entry> m_entries;
+    std::atomic<bool>                      m_enabled { false }; //Lets callers skip the lock while no rule is set
+    std::atomic<uint64_t>                  m_hits { 0 };
+    std::atomic<uint64_t>                  m_misses { 0 };
+    std::atomic<uint64_t>                  m_flushes { 0 };
+};
+
+} // namespace Plugin
+
+} // namespace WPEFramework
+#endif /* RESPONSECACHE_H */
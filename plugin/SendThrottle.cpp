@@ -0,0 +1,135 @@
+/**
+* If not stated otherwise in this file or this component's LICENSE
+* file the following copyright and licenses apply:
+*
+* Copyright 2024 RDK Management
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+**/
+
+#include <algorithm>
+
+#include "Module.h"
+#include "SendThrottle.h"
+
+namespace WPEFramework
+{
+
+namespace Plugin
+{
+
+void SendThrottle::configure(uint32_t t_rate, uint32_t t_burst, uint32_t t_maxInflight)
+{
+    std::lock_guard<std::mutex> lock(m_lock);
+
+    m_rate = t_rate;
+    m_burst = std::max<uint32_t>(t_burst, 1);
+    m_maxInflight = t_maxInflight;
+    m_clients.clear();
+}
+
+SendThrottle::Admission SendThrottle::admit(uint32_t t_channelId)
+{
+    std::lock_guard<std::mutex> lock(m_lock);
+
+    if ((0 == m_rate) && (0 == m_maxInflight))
+    {
+        return ADMITTED;
+    }
+
+    const Clock::time_point now = Clock::now();
+    std::map<uint32_t, Client>::iterator client = m_clients.find(t_channelId);
+    if (m_clients.end() == client)
+    {
+        if (m_clients.size() >= MAX_CLIENTS)
+        {
+            evictIdleClients(now);
+        }
+        if (m_clients.size() >= MAX_CLIENTS)
+        {
+            return CLIENTS_LIMITED;
+        }
+        client = m_clients.emplace(t_channelId, Client { static_cast<double>(m_burst), now, 0, 0, 0, 0 }).first;
+    }
+
+    Client& state = client->second;
+    if ((0 != m_maxInflight) && (state.inflight >= m_maxInflight))
+    {
+        state.inflightLimited++;
+        return INFLIGHT_LIMITED;
+    }
+
+    if (0 != m_rate)
+    {
+        const double elapsed = std::chrono::duration<double>(now - state.refilled).count();
+        state.tokens = std::min<double>(m_burst, state.tokens + (elapsed * m_rate));
+        state.refilled = now;
+        if (state.tokens < 1.0)
+        {
+            state.rateLimited++;
+            return RATE_LIMITED;
+        }
+        state.tokens -= 1.0;
+    }
+
+    state.inflight++;
+    state.admitted++;
+    return ADMITTED;
+}
+
+void SendThrottle::release(uint32_t t_channelId)
+{
+    std::lock_guard<std::mutex> lock(m_lock);
+
+    std::map<uint32_t, Client>::iterator client = m_clients.find(t_channelId);
+    if ((m_clients.end() != client) && (client->second.inflight > 0))
+    {
+        client->second.inflight--;
+    }
+}
+
+void SendThrottle::drop(uint32_t t_channelId)
+{
+    std::lock_guard<std::mutex> lock(m_lock);
+
+    m_clients.erase(t_channelId);
+}
+
+std::vector<SendThrottle::ClientStats> SendThrottle::stats()
+{
+    std::lock_guard<std::mutex> lock(m_lock);
+
+    std::vector<ClientStats> result;
+    result.reserve(m_clients.size());
+    for (const std::pair<const uint32_t, Client>& client : m_clients)
+    {
+        result.push_back({ client.first, client.second.inflight, client.second.admitted,
+                           client.second.rateLimited, client.second.inflightLimited });
+    }
+    return result;
+}
+
+void SendThrottle::evictIdleClients(Clock::time_point t_now)
+{
+    // Clients with nothing pending and a full bucket would start over the same way, so they make room first.
+    for (std::map<uint32_t, Client>::iterator client = m_clients.begin(); client != m_clients.end();)
+    {
+        const double elapsed = std::chrono::duration<double>(t_now - client->second.refilled).count();
+        const bool refilled = ((0 == m_rate) || ((client->second.tokens + (elapsed * m_rate)) >= m_burst));
+        client = ((0 == client->second.inflight) && refilled) ? m_clients.erase(client) : std::next(client);
+    }
+}
+
+} // namespace Plugin
+
+} // namespace WPEFramework
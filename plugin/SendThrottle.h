@@ -0,0 +1,164 @@
+/**
+* If not stated otherwise in this file or this component's LICENSE
+* file the following copyright and licenses apply:
+*
+* Copyright 2024 RDK Management
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+**/
+
+#ifndef SENDTHROTTLE_H
+#define SENDTHROTTLE_H
+
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <vector>
+
+namespace WPEFramework
+{
+
+namespace Plugin
+{
+
+/**
+ * @brief   Per-client admission control for send.
+ * @details Every JSON-RPC channel gets a token bucket refilled at a fixed rate and a cap on the
+ *          sends it may have executing at once. A zero rate or cap disables that limit.
+ *          At most MAX_CLIENTS channels are tracked; a new channel is refused while all of them are busy.
+ */
+class SendThrottle
+{
+
+public:
+    static constexpr uint32_t MAX_CLIENTS = 64;
+
+    enum Admission : uint8_t
+    {
+        ADMITTED,
+        RATE_LIMITED,
+        INFLIGHT_LIMITED,
+        CLIENTS_LIMITED
+    };
+
+    struct ClientStats
+    {
+        uint32_t channelId;
+        uint32_t inflight;
+        uint64_t admitted;
+        uint64_t rateLimited;
+        uint64_t inflightLimited;
+    };
+
+    /**
+     * @brief Admission of one send, released when it goes out of scope.
+     */
+    class Ticket
+    {
+    public:
+        Ticket() = delete;
+        Ticket(const Ticket&) = delete;
+        Ticket& operator=(const Ticket&) = delete;
+
+        Ticket(SendThrottle& t_throttle, uint32_t t_channelId)
+            : m_throttle(t_throttle)
+            , m_channelId(t_channelId)
+            , m_admission(t_throttle.admit(t_channelId))
+        {
+        }
+
+        ~Ticket()
+        {
+            if (ADMITTED == m_admission)
+            {
+                m_throttle.release(m_channelId);
+            }
+        }
+
+        Admission admission() const
+        {
+            return m_admission;
+        }
+
+    private:
+        SendThrottle&   m_throttle;
+        const uint32_t  m_channelId;
+        const Admission m_admission;
+    };
+
+    SendThrottle() = default;
+    SendThrottle(const SendThrottle&) = delete;
+    SendThrottle& operator=(const SendThrottle&) = delete;
+
+    /**
+     * @brief     This method sets the limits applied to every client and forgets all clients.
+     *
+     * @parm[in]  t_rate        Sends per second each client may sustain, 0 for no rate limit.
+     * @parm[in]  t_burst       Sends a client may issue at once after being idle.
+     * @parm[in]  t_maxInflight Sends a client may have executing at once, 0 for no limit.
+     *
+     * @return    None
+     */
+    void configure(uint32_t t_rate, uint32_t t_burst, uint32_t t_maxInflight);
+
+    /**
+     * @brief     This method decides whether a client may send now.
+     * @details   An admitted send must be paired with release().
+     *
+     * @parm[in]  t_channelId JSON-RPC channel of the client.
+     *
+     * @return    ADMITTED, or the limit the client ran into.
+     */
+    Admission admit(uint32_t t_channelId);
+
+    void release(uint32_t t_channelId);
+
+    /**
+     * @brief     This method forgets a client whose channel closed.
+     * @details   Sends of the client still executing are released without effect.
+     *
+     * @parm[in]  t_channelId JSON-RPC channel of the client.
+     *
+     * @return    None
+     */
+    void drop(uint32_t t_channelId);
+
+    std::vector<ClientStats> stats();
+
+private:
+    typedef std::chrono::steady_clock Clock;
+
+    struct Client
+    {
+        double            tokens;
+        Clock::time_point refilled;
+        uint32_t          inflight;
+        uint64_t          admitted;
+        uint64_t          rateLimited;
+        uint64_t          inflightLimited;
+    };
+
+    void evictIdleClients(Clock::time_point t_now);
+
+    std::mutex                   m_lock; //Protects the limits and clients
+    uint32_t                     m_rate = 0;
+    uint32_t                     m_burst = 0;
+    uint32_t                     m_maxInflight = 0;
+    std::map<uint32_t, Client>   m_clients;
+};
+
+} // namespace Plugin
+
+} // namespace WPEFramework
+#endif /* SENDTHROTTLE_H */
@@ -0,0 +1,122 @@
+/**
+* If not stated otherwise in this file or this component's LICENSE
+* file the following copyright and licenses apply:
+*
+* Copyright 2024 RDK Management
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+**/
+
+
+#include <algorithm>
+
+#include "SessionScheduler.h"
+
+namespace WPEFramework
+{
+
+namespace Plugin
+{
+
+SessionScheduler::Ticket SessionScheduler::enqueue(SessionPriority t_priority)
+{
+    std::list<Request>::iterator position = m_queue.begin();
+    while ((m_queue.end() != position) && (position->priority >= t_priority))
+    {
+        ++position;
+    }
+    const Ticket ticket = m_nextTicket++;
+    m_queue.insert(position, { ticket, t_priority });
+    ++m_waits;
+    return ticket;
+}
+
+void SessionScheduler::dequeue(Ticket t_ticket)
+{
+    m_queue.remove_if([t_ticket](const Request& request) { return request.ticket == t_ticket; });
+}
+
+bool SessionScheduler::isNext(Ticket t_ticket) const
+{
+    return (false == m_queue.empty()) && (m_queue.front().ticket == t_ticket);
+}
+
+bool SessionScheduler::admits(SessionPriority t_priority) const
+{
+    return m_queue.empty() || (m_queue.front().priority < t_priority);
+}
+
+bool SessionScheduler::preempts(SessionPriority t_priority) const
+{
+    return m_held && (t_priority > m_holder);
+}
+
+void SessionScheduler::acquire(SessionPriority t_priority)
+{
+    m_held = true;
+    m_holder = t_priority;
+    m_heldSince = Clock::now();
+}
+
+void SessionScheduler::release(bool t_preempted)
+{
+    if (false == m_held)
+    {
+        return;
+    }
+    m_held = false;
+    if (t_preempted)
+    {
+        ++m_preemptions;
+        return;
+    }
+    const uint32_t heldMs = static_cast<uint32_t>(std::chrono::duration_cast<std::chrono::milliseconds>(Clock::now() - m_heldSince).count());
+    uint32_t& average = m_averageHoldMs[static_cast<uint8_t>(m_holder)];
+    average = (0 == average) ? heldMs : static_cast<uint32_t>((static_cast<uint64_t>(average) * 7 + heldMs) / 8);
+}
+
+uint32_t SessionScheduler::expectedWaitMs(SessionPriority t_priority) const
+{
+    if ((false == m_held) && admits(t_priority))
+    {
+        return 0;
+    }
+    if (preempts(t_priority))
+    {
+        return 0;
+    }
+
+    uint64_t heldMs = 0;
+    uint64_t waitMs = 0;
+    if (m_held)
+    {
+        heldMs = std::chrono::duration_cast<std::chrono::milliseconds>(Clock::now() - m_heldSince).count();
+        const uint32_t average = m_averageHoldMs[static_cast<uint8_t>(m_holder)];
+        const uint64_t expectedMs = (0 == average) ? (2 * heldMs) : average;
+        waitMs = (expectedMs > heldMs) ? (expectedMs - heldMs) : 0;
+    }
+    for (const Request& request : m_queue)
+    {
+        if (request.priority < t_priority)
+        {
+            break;
+        }
+        const uint32_t average = m_averageHoldMs[static_cast<uint8_t>(request.priority)];
+        waitMs += (0 == average) ? heldMs : average;
+    }
+    return static_cast<uint32_t>(std::min<uint64_t>(waitMs, UINT32_MAX));
+}
+
+} // namespace Plugin
+
+} // namespace WPEFramework
@@ -0,0 +1,166 @@
+/**
+* If not stated otherwise in this file or this component's LICENSE
+* file the following copyright and licenses apply:
+*
+* Copyright 2024 RDK Management
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+**/
+
+
+#ifndef SESSIONSCHEDULER_H
+#define SESSIONSCHEDULER_H
+
+#include <chrono>
+#include <cstdint>
+#include <list>
+
+namespace WPEFramework
+{
+
+namespace Plugin
+{
+
+// Claim of a management session on the tuner and descrambler, highest last.
+enum class SessionPriority : uint8_t
+{
+    PRIORITY_BACKGROUND, // Background EMM collection
+    PRIORITY_RECORDING,
+    PRIORITY_LIVE
+};
+
+/**
+ * @brief   Arbitrates the tuner and descrambler slot of the management session between manage requests.
+ * @details A request of higher priority than the session holding the slot pre-empts it; other requests
+ *          may queue and are admitted by priority, then in arrival order, as the slot is released.
+ *          Hold times are tracked per priority to estimate how long a request would wait.
+ *          Not thread-safe; the caller serializes access with its session lock.
+ */
+class SessionScheduler
+{
+
+public:
+    typedef uint64_t Ticket;
+
+    SessionScheduler() = default;
+    SessionScheduler(const SessionScheduler&) = delete;
+    SessionScheduler& operator=(const SessionScheduler&) = delete;
+
+    /**
+     * @brief     This method queues a request for the slot.
+     *
+     * @return    Ticket identifying the request in the queue.
+     */
+    Ticket enqueue(SessionPriority t_priority);
+
+    /**
+     * @brief     This method removes a request from the queue, once admitted or given up.
+     *
+     * @return    None
+     */
+    void dequeue(Ticket t_ticket);
+
+    /**
+     * @brief     This method tells whether a queued request is the next to be admitted.
+     */
+    bool isNext(Ticket t_ticket) const;
+
+    /**
+     * @brief     This method tells whether a request that does not queue may take the free slot.
+     * @details   Queued requests of the same or higher priority go first.
+     */
+    bool admits(SessionPriority t_priority) const;
+
+    /**
+     * @brief     This method tells whether a request may pre-empt the session holding the slot.
+     */
+    bool preempts(SessionPriority t_priority) const;
+
+    /**
+     * @brief     This method records that a session of the given priority took the slot.
+     *
+     * @return    None
+     */
+    void acquire(SessionPriority t_priority);
+
+    /**
+     * @brief     This method records that the session holding the slot released it.
+     *
+     * @parm[in]  t_preempted True when the session was pre-empted, its hold time is then not sampled.
+     *
+     * @return    None
+     */
+    void release(bool t_preempted = false);
+
+    /**
+     * @brief     This method estimates how long a request would wait for the slot.
+     * @details   Sums the remaining hold time of the current session and the expected hold times of
+     *            the queued requests going first. Until a hold of some priority has been observed, its
+     *            sessions are expected to last as long again as the current one already has.
+     *
+     * @return    Estimated wait in ms, 0 when the request would be admitted right away.
+     */
+    uint32_t expectedWaitMs(SessionPriority t_priority) const;
+
+    uint32_t queued() const
+    {
+        return static_cast<uint32_t>(m_queue.size());
+    }
+
+    uint32_t preemptions() const
+    {
+        return m_preemptions;
+    }
+
+    uint32_t waits() const
+    {
+        return m_waits;
+    }
+
+    uint32_t waitTimeouts() const
+    {
+        return m_waitTimeouts;
+    }
+
+    void countWaitTimeout()
+    {
+        ++m_waitTimeouts;
+    }
+
+private:
+    typedef std::chrono::steady_clock Clock;
+
+    struct Request
+    {
+        Ticket          ticket;
+        SessionPriority priority;
+    };
+
+    static constexpr uint8_t PRIORITIES = static_cast<uint8_t>(SessionPriority::PRIORITY_LIVE) + 1;
+
+    std::list<Request> m_queue; //Ordered by priority, then arrival
+    Ticket             m_nextTicket = 1;
+    bool               m_held = false; //True while a session holds the slot
+    SessionPriority    m_holder = SessionPriority::PRIORITY_BACKGROUND; //Priority of that session
+    Clock::time_point  m_heldSince;
+    uint32_t           m_averageHoldMs[PRIORITIES] = {}; //Moving average of completed holds, 0 until sampled
+    uint32_t           m_preemptions = 0;
+    uint32_t           m_waits = 0;
+    uint32_t           m_waitTimeouts = 0;
+};
+
+} // namespace Plugin
+
+} // namespace WPEFramework
+
+#endif /* SESSIONSCHEDULER_H */
@@ -0,0 +1,204 @@
+/**
+* If not stated otherwise in this file or this component's LICENSE
+* file the following copyright and licenses apply:
+*
+* Copyright 2024 RDK Management
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+**/
+
+#include <atomic>
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "Module.h"
+#include "SessionSnapshot.h"
+#include "UtilsLogging.h"
+
+namespace WPEFramework
+{
+
+namespace Plugin
+{
+
+SessionSnapshot::~SessionSnapshot()
+{
+    close();
+}
+
+void SessionSnapshot::configure(std::string&& t_prefix)
+{
+    std::lock_guard<std::mutex> lock(m_lock);
+    m_casStatePrefix = std::move(t_prefix);
+    m_casStateEnabled = (false == m_casStatePrefix.empty());
+}
+
+bool SessionSnapshot::open(const std::string& t_path)
+{
+    std::lock_guard<std::mutex> lock(m_lock);
+
+    if (nullptr != m_layout)
+    {
+        return true;
+    }
+
+    int fd = ::open(t_path.c_str(), O_CREAT | O_RDWR | O_CLOEXEC, S_IRUSR | S_IWUSR);
+    if (fd < 0)
+    {
+        LOGERR("open(%s) failed: %s", t_path.c_str(), strerror(errno));
+        return false;
+    }
+
+    struct stat info;
+    const bool fresh = ((0 != fstat(fd, &info)) || (static_cast<std::size_t>(info.st_size) != sizeof(Layout)));
+    if (fresh && (0 != ftruncate(fd, sizeof(Layout))))
+    {
+        LOGERR("ftruncate(%s) failed: %s", t_path.c_str(), strerror(errno));
+        ::close(fd);
+        return false;
+    }
+
+    void* base = mmap(nullptr, sizeof(Layout), PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (MAP_FAILED == base)
+    {
+        LOGERR("mmap(%s) failed: %s", t_path.c_str(), strerror(errno));
+        return false;
+    }
+
+    m_layout = static_cast<Layout*>(base);
+    if (fresh || (MAGIC != m_layout->magic) || (VERSION != m_layout->version))
+    {
+        memset(m_layout, 0, sizeof(Layout));
+        m_layout->magic = MAGIC;
+        m_layout->version = VERSION;
+    }
+    return true;
+}
+
+void SessionSnapshot::close()
+{
+    std::lock_guard<std::mutex> lock(m_lock);
+
+    if (nullptr != m_layout)
+    {
+        munmap(m_layout, sizeof(Layout));
+        m_layout = nullptr;
+    }
+}
+
+bool SessionSnapshot::load(Descriptor& t_descriptor)
+{
+    std::lock_guard<std::mutex> lock(m_lock);
+
+    if ((nullptr == m_layout) || (SLOT_ACTIVE != m_layout->state) ||
+        (m_layout->mediaurlLength > MAX_MEDIAURL) || (m_layout->casinitdataLength > MAX_CASINITDATA) ||
+        (m_layout->casocdmidLength > MAX_CASOCDMID) || (m_layout->casStateLength > MAX_CASSTATE) ||
+        (false == manageModeValid(m_layout->manage)))
+    {
+        return false;
+    }
+
+    t_descriptor.sessionId = m_layout->sessionId;
+    t_descriptor.manage = static_cast<ManageMode>(m_layout->manage);
+    t_descriptor.mediaurl.assign(m_layout->mediaurl, m_layout->mediaurlLength);
+    t_descriptor.casinitdata.assign(m_layout->casinitdata, m_layout->casinitdataLength);
+    t_descriptor.casocdmid.assign(m_layout->casocdmid, m_layout->casocdmidLength);
+    t_descriptor.casState.assign(m_layout->casState, m_layout->casStateLength);
+    return true;
+}
+
+bool SessionSnapshot::store(const Descriptor& t_descriptor)
+{
+    std::lock_guard<std::mutex> lock(m_lock);
+
+    if (nullptr == m_layout)
+    {
+        return false;
+    }
+
+    setState(SLOT_WRITING);
+    if ((t_descriptor.mediaurl.size() > MAX_MEDIAURL) || (t_descriptor.casinitdata.size() > MAX_CASINITDATA) ||
+        (t_descriptor.casocdmid.size() > MAX_CASOCDMID) || (t_descriptor.casState.size() > MAX_CASSTATE))
+    {
+        LOGWARN("Session %u is too large for the snapshot and will not be restored", t_descriptor.sessionId);
+        setState(SLOT_EMPTY);
+        return false;
+    }
+
+    m_layout->sessionId = t_descriptor.sessionId;
+    m_layout->manage = static_cast<uint8_t>(t_descriptor.manage);
+    m_layout->mediaurlLength = static_cast<uint32_t>(t_descriptor.mediaurl.size());
+    memcpy(m_layout->mediaurl, t_descriptor.mediaurl.data(), m_layout->mediaurlLength);
+    m_layout->casinitdataLength = static_cast<uint32_t>(t_descriptor.casinitdata.size());
+    memcpy(m_layout->casinitdata, t_descriptor.casinitdata.data(), m_layout->casinitdataLength);
+    m_layout->casocdmidLength = static_cast<uint32_t>(t_descriptor.casocdmid.size());
+    memcpy(m_layout->casocdmid, t_descriptor.casocdmid.data(), m_layout->casocdmidLength);
+    m_layout->casStateLength = static_cast<uint32_t>(t_descriptor.casState.size());
+    memcpy(m_layout->casState, t_descriptor.casState.data(), m_layout->casStateLength);
+    setState(SLOT_ACTIVE);
+    return true;
+}
+
+bool SessionSnapshot::updateCasState(const std::string& t_payload)
+{
+    if (false == m_casStateEnabled.load(std::memory_order_relaxed))
+    {
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(m_lock);
+
+    if ((nullptr == m_layout) || (SLOT_ACTIVE != m_layout->state) ||
+        (0 != t_payload.compare(0, m_casStatePrefix.size(), m_casStatePrefix)))
+    {
+        return false;
+    }
+    if (t_payload.size() > MAX_CASSTATE)
+    {
+        LOGWARN("CAS state of %zu bytes exceeds the snapshot slot, keeping the previous state", t_payload.size());
+        return false;
+    }
+
+    setState(SLOT_WRITING);
+    m_layout->casStateLength = static_cast<uint32_t>(t_payload.size());
+    memcpy(m_layout->casState, t_payload.data(), m_layout->casStateLength);
+    setState(SLOT_ACTIVE);
+    return true;
+}
+
+void SessionSnapshot::clear()
+{
+    std::lock_guard<std::mutex> lock(m_lock);
+
+    if (nullptr != m_layout)
+    {
+        setState(SLOT_EMPTY);
+    }
+}
+
+void SessionSnapshot::setState(SlotState t_state)
+{
+    // Keeps the field stores on the right side of the state change should the process die in between.
+    std::atomic_signal_fence(std::memory_order_seq_cst);
+    m_layout->state = t_state;
+    std::atomic_signal_fence(std::memory_order_seq_cst);
+}
+
+} // namespace Plugin
+
+} // namespace WPEFramework
@@ -0,0 +1,167 @@
+/**
+* If not stated otherwise in this file or this component's LICENSE
+* file the following copyright and licenses apply:
+*
+* Copyright 2024 RDK Management
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+**/
+
+#ifndef SESSIONSNAPSHOT_H
+#define SESSIONSNAPSHOT_H
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include "ManageMode.h"
+
+namespace WPEFramework
+{
+
+namespace Plugin
+{
+
+/**
+ * @brief   Memory-mapped record of the active management session, kept for warm restarts.
+ * @details The file holds one fixed-size SessionSnapshot::Layout. Stores go straight into the
+ *          shared mapping, so the record survives a crash of the hosting process without any
+ *          explicit flush. A slot is marked SLOT_WRITING while it changes; a slot found in that
+ *          state after a crash is ignored.
+ */
+class SessionSnapshot
+{
+
+public:
+    static constexpr uint32_t MAGIC = 0x53534355; //"UCSS"
+    static constexpr uint16_t VERSION = 1;
+    static constexpr uint32_t MAX_MEDIAURL = 1024;
+    static constexpr uint32_t MAX_CASINITDATA = 4096;
+    static constexpr uint32_t MAX_CASOCDMID = 256;
+    static constexpr uint32_t MAX_CASSTATE = 1024;
+
+    enum SlotState : uint32_t
+    {
+        SLOT_EMPTY = 0,
+        SLOT_WRITING = 1,
+        SLOT_ACTIVE = 2
+    };
+
+    struct Descriptor
+    {
+        uint32_t    sessionId = 0;
+        ManageMode  manage = ManageMode::MANAGE_FULL;
+        std::string mediaurl;
+        std::string casinitdata;
+        std::string casocdmid;
+        std::string casState; //Last data event payload of the session carrying CAS state
+    };
+
+    SessionSnapshot() = default;
+    SessionSnapshot(const SessionSnapshot&) = delete;
+    SessionSnapshot& operator=(const SessionSnapshot&) = delete;
+    ~SessionSnapshot();
+
+    /**
+     * @brief     This method sets which data events carry the CAS state recorded with the session.
+     *
+     * @parm[in]  t_prefix Leading bytes of those events, empty to record no CAS state.
+     *
+     * @return    None
+     */
+    void configure(std::string&& t_prefix);
+
+    /**
+     * @brief     This method maps the snapshot file, creating it if needed.
+     * @details   A file with a foreign layout is reset.
+     *
+     * @parm[in]  t_path Location of the snapshot file.
+     *
+     * @return    true if the snapshot is ready.
+     */
+    bool open(const std::string& t_path);
+
+    void close();
+
+    /**
+     * @brief     This method reads the recorded session.
+     *
+     * @parm[out] t_descriptor Recorded session.
+     *
+     * @return    true if a complete session record was found.
+     */
+    bool load(Descriptor& t_descriptor);
+
+    /**
+     * @brief     This method records the active session, replacing any previous record.
+     *
+     * @return    false if the snapshot is closed or a field exceeds its slot.
+     */
+    bool store(const Descriptor& t_descriptor);
+
+    /**
+     * @brief     This method updates the last-known CAS state of the recorded session.
+     * @details   Only payloads starting with the configured prefix are recorded. A payload longer
+     *            than MAX_CASSTATE is refused and the previous state kept, rather than restoring a
+     *            truncated one.
+     *
+     * @parm[in]  t_payload Data event payload.
+     *
+     * @return    true if the payload was recorded.
+     */
+    bool updateCasState(const std::string& t_payload);
+
+    /**
+     * @brief     This method drops the recorded session.
+     *
+     * @return    None
+     */
+    void clear();
+
+    bool isOpen() const
+    {
+        return (nullptr != m_layout);
+    }
+
+private:
+    struct Layout
+    {
+        uint32_t magic;
+        uint16_t version;
+        uint16_t reserved;
+        uint32_t state;
+        uint32_t sessionId;
+        uint8_t  manage;
+        uint8_t  padding[3];
+        uint32_t mediaurlLength;
+        uint32_t casinitdataLength;
+        uint32_t casocdmidLength;
+        uint32_t casStateLength;
+        char     mediaurl[MAX_MEDIAURL];
+        char     casinitdata[MAX_CASINITDATA];
+        char     casocdmid[MAX_CASOCDMID];
+        char     casState[MAX_CASSTATE];
+    };
+
+    void setState(SlotState t_state);
+
+    std::mutex        m_lock; //Serializes manage/unmanage updates against event updates
+    Layout*           m_layout = nullptr;
+    std::string       m_casStatePrefix;
+    std::atomic<bool> m_casStateEnabled { false }; //Lets the data event path skip the lock while no prefix is set
+};
+
+} // namespace Plugin
+
+} // namespace WPEFramework
+#endif /* SESSIONSNAPSHOT_H */
@@ -0,0 +1,223 @@
+/**
+* If not stated otherwise in this file or this component's LICENSE
+* file the following copyright and licenses apply:
+*
+* Copyright 2024 RDK Management
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+**/
+
+
+#include <cerrno>
+#include <cstring>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "Module.h"
+#include "TrafficLog.h"
+#include "UtilsLogging.h"
+
+static void appendVarint(std::string& t_buffer, uint64_t t_value)
+{
+    while (t_value >= 0x80)
+    {
+        t_buffer.push_back(static_cast<char>((t_value & 0x7F) | 0x80));
+        t_value >>= 7;
+    }
+    t_buffer.push_back(static_cast<char>(t_value));
+}
+
+static void appendString(std::string& t_buffer, const std::string& t_value)
+{
+    appendVarint(t_buffer, t_value.size());
+    t_buffer.append(t_value);
+}
+
+namespace WPEFramework
+{
+
+namespace Plugin
+{
+
+constexpr const char TrafficLog::MAGIC[8];
+constexpr uint64_t TrafficLog::DEFAULT_MAX_SIZE;
+
+TrafficLog::Writer::~Writer()
+{
+    close();
+}
+
+bool TrafficLog::Writer::open(const std::string& t_path, uint64_t t_maxSize)
+{
+    std::lock_guard<std::mutex> lock(m_lock);
+    if (nullptr != m_file)
+    {
+        fclose(m_file);
+        m_file = nullptr;
+    }
+    // The log holds CAS payloads, so it is kept from other users even when it replaces an existing file.
+    const int fd = ::open(t_path.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_NOFOLLOW | O_CLOEXEC, S_IRUSR | S_IWUSR);
+    if ((fd < 0) || (0 != fchmod(fd, S_IRUSR | S_IWUSR)) || (nullptr == (m_file = fdopen(fd, "wb"))))
+    {
+        LOGERR("Failed to create traffic log %s: %s", t_path.c_str(), strerror(errno));
+        if (fd >= 0)
+        {
+            ::close(fd);
+        }
+        return false;
+    }
+    fwrite(MAGIC, 1, sizeof(MAGIC), m_file);
+    m_opened = std::chrono::steady_clock::now();
+    m_lastUs = 0;
+    m_size = sizeof(MAGIC);
+    m_maxSize = t_maxSize;
+    m_active = true;
+    LOGINFO("Capturing traffic to %s", t_path.c_str());
+    return true;
+}
+
+void TrafficLog::Writer::close()
+{
+    std::lock_guard<std::mutex> lock(m_lock);
+    m_active = false;
+    if (nullptr != m_file)
+    {
+        fclose(m_file);
+        m_file = nullptr;
+    }
+}
+
+void TrafficLog::Writer::record(Kind t_kind, uint32_t t_id, const std::string& t_text, const std::string& t_source, int64_t t_code)
+{
+    std::lock_guard<std::mutex> lock(m_lock);
+    if (nullptr == m_file)
+    {
+        return;
+    }
+
+    const uint64_t nowUs = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(
+                               std::chrono::steady_clock::now() - m_opened).count());
+    m_buffer.clear();
+    m_buffer.push_back(static_cast<char>(t_kind));
+    appendVarint(m_buffer, nowUs - m_lastUs);
+    appendVarint(m_buffer, t_id);
+    if (Kind::PLAYER_ERROR == t_kind)
+    {
+        appendVarint(m_buffer, (static_cast<uint64_t>(t_code) << 1) ^ static_cast<uint64_t>(t_code >> 63));
+    }
+    appendString(m_buffer, t_text);
+    appendString(m_buffer, t_source);
+    m_lastUs = nowUs;
+
+    if (m_size + m_buffer.size() > m_maxSize)
+    {
+        LOGWARN("Traffic log reached %llu bytes, capture stopped", static_cast<unsigned long long>(m_maxSize));
+        m_active = false;
+        fclose(m_file);
+        m_file = nullptr;
+        return;
+    }
+    m_size += m_buffer.size();
+    if (m_buffer.size() != fwrite(m_buffer.data(), 1, m_buffer.size(), m_file))
+    {
+        LOGERR("Traffic log write failed, capture stopped");
+        m_active = false;
+        fclose(m_file);
+        m_file = nullptr;
+    }
+}
+
+TrafficLog::Reader::~Reader()
+{
+    if (nullptr != m_file)
+    {
+        fclose(m_file);
+    }
+}
+
+bool TrafficLog::Reader::open(const std::string& t_path)
+{
+    m_file = fopen(t_path.c_str(), "rb");
+    if (nullptr == m_file)
+    {
+        return false;
+    }
+    char magic[sizeof(MAGIC)];
+    m_timeUs = 0;
+    return (sizeof(magic) == fread(magic, 1, sizeof(magic), m_file)) && (0 == memcmp(magic, MAGIC, sizeof(MAGIC)));
+}
+
+bool TrafficLog::Reader::next(Record& t_record)
+{
+    if (nullptr == m_file)
+    {
+        return false;
+    }
+    const int kind = fgetc(m_file);
+    if ((EOF == kind) || (kind < static_cast<int>(Kind::MANAGE)) || (kind > static_cast<int>(Kind::SEND_END)))
+    {
+        return false;
+    }
+    t_record.kind = static_cast<Kind>(kind);
+
+    uint64_t deltaUs = 0;
+    uint64_t id = 0;
+    uint64_t code = 0;
+    if ((false == readVarint(deltaUs)) || (false == readVarint(id)) ||
+        ((Kind::PLAYER_ERROR == t_record.kind) && (false == readVarint(code))) ||
+        (false == readString(t_record.text)) || (false == readString(t_record.source)))
+    {
+        return false;
+    }
+    m_timeUs += deltaUs;
+    t_record.timeUs = m_timeUs;
+    t_record.id = static_cast<uint32_t>(id);
+    t_record.code = static_cast<int64_t>(code >> 1) ^ -static_cast<int64_t>(code & 1);
+    return true;
+}
+
+bool TrafficLog::Reader::readVarint(uint64_t& t_value)
+{
+    t_value = 0;
+    for (uint32_t shift = 0; shift < 64; shift += 7)
+    {
+        const int byte = fgetc(m_file);
+        if (EOF == byte)
+        {
+            return false;
+        }
+        t_value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+        if (0 == (byte & 0x80))
+        {
+            return true;
+        }
+    }
+    return false;
+}
+
+bool TrafficLog::Reader::readString(std::string& t_value)
+{
+    uint64_t size = 0;
+    // A corrupt length must not turn into a huge allocation.
+    if ((false == readVarint(size)) || (size > MAX_TEXT_SIZE))
+    {
+        return false;
+    }
+    t_value.resize(size);
+    return (0 == size) || (size == fread(&t_value[0], 1, size, m_file));
+}
+
+} // namespace Plugin
+
+} // namespace WPEFramework
@@ -0,0 +1,164 @@
+/**
+* If not stated otherwise in this file or this component's LICENSE
+* file the following copyright and licenses apply:
+*
+* Copyright 2024 RDK Management
+*
+* Licensed under the Apache License, Version 2.0 (the "License");
+* you may not use this file except in compliance with the License.
+* You may obtain a copy of the License at
+*
+* http://www.apache.org/licenses/LICENSE-2.0
+*
+* Unless required by applicable law or agreed to in writing, software
+* distributed under the License is distributed on an "AS IS" BASIS,
+* WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+* See the License for the specific language governing permissions and
+* limitations under the License.
+**/
+
+
+#ifndef TRAFFICLOG_H
+#define TRAFFICLOG_H
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <mutex>
+#include <string>
+
+namespace WPEFramework
+{
+
+namespace Plugin
+{
+
+/**
+ * @brief   Compact binary log of the JSON-RPC calls and player callbacks a plugin instance handled.
+ * @details The log starts with MAGIC and holds one record per call or callback. Every record is
+ *          its kind byte followed by varints for the time since the previous record (us), the id the
+ *          kind documents, for errors the zigzag-encoded code, and the length-prefixed text and source.
+ *          Captured logs are driven back into the plugin by the ucasreplay tool.
+ */
+class TrafficLog
+{
+
+public:
+    static constexpr const char MAGIC[8] = { 'U', 'C', 'A', 'S', 'T', 'R', 'F', '1' };
+    static constexpr uint64_t MAX_TEXT_SIZE = 64 * 1024 * 1024; //Largest text a reader accepts
+    static constexpr uint64_t DEFAULT_MAX_SIZE = 64 * 1024 * 1024; //Size at which a writer stops capturing
+
+    enum class Kind : uint8_t
+    {
+        MANAGE = 1, //Parameters of a manage call, id is 0: the session is shared by all channels
+        SEND = 2, //Parameters of a send call, id is the JSON-RPC channel
+        UNMANAGE = 3, //Parameters of an unmanage call, id is 0 like MANAGE
+        DATA_EVENT = 4, //Data event payload and source, id is the session
+        PLAYER_ERROR = 5, //Player error code, id is the session
+        SEND_BEGIN = 6, //Parameters of a sendBegin call, id is the JSON-RPC channel
+        SEND_CHUNK = 7, //Parameters of a sendChunk call, id is the JSON-RPC channel
+        SEND_END = 8 //Parameters of a sendEnd call, id is the JSON-RPC channel
+    };
+
+    /**
+     * @brief     This method tells JSON-RPC calls from player callbacks.
+     */
+    static bool isCall(Kind t_kind)
+    {
+        return (Kind::DATA_EVENT != t_kind) && (Kind::PLAYER_ERROR != t_kind);
+    }
+
+    struct Record
+    {
+        Kind        kind = Kind::MANAGE;
+        uint64_t    timeUs = 0; //Time since the log was opened
+        uint32_t    id = 0;
+        int64_t     code = 0;
+        std::string text;
+        std::string source;
+    };
+
+    /**
+     * @brief   Appends records to a log file; safe to use from several threads.
+     */
+    class Writer
+    {
+    public:
+        Writer() = default;
+        ~Writer();
+
+        Writer(const Writer&) = delete;
+        Writer& operator=(const Writer&) = delete;
+
+        /**
+         * @brief     This method creates the log file readable by the owner only, replacing an existing one.
+         * @details   Capture stops once the file would grow beyond t_maxSize.
+         *
+         * @return    true if the file could be created.
+         */
+        bool open(const std::string& t_path, uint64_t t_maxSize = DEFAULT_MAX_SIZE);
+        void close();
+
+        bool active() const
+        {
+            return m_active.load(std::memory_order_relaxed);
+        }
+
+        /**
+         * @brief     This method appends a record timestamped now.
+         *
+         * @return    None
+         */
+        void record(Kind t_kind, uint32_t t_id, const std::string& t_text, const std::string& t_source = std::string(), int64_t t_code = 0);
+
+    private:
+        std::mutex                            m_lock; //Serializes records and their time deltas
+        FILE*                                 m_file = nullptr;
+        std::atomic<bool>                     m_active { false }; //Lets callers skip formatting while not capturing
+        std::chrono::steady_clock::time_point m_opened;
+        uint64_t                              m_lastUs = 0;
+        uint64_t                              m_size = 0; //Bytes written so far
+        uint64_t                              m_maxSize = DEFAULT_MAX_SIZE;
+        std::string                           m_buffer; //Encoding of the current record, reused
+    };
+
+    /**
+     * @brief   Reads the records of a log file in order.
+     */
+    class Reader
+    {
+    public:
+        Reader() = default;
+        ~Reader();
+
+        Reader(const Reader&) = delete;
+        Reader& operator=(const Reader&) = delete;
+
+        /**
+         * @brief     This method opens a log file and checks its header.
+         *
+         * @return    true if the file is a traffic log.
+         */
+        bool open(const std::string& t_path);
+
+        /**
+         * @brief     This method reads the next record.
+         *
+         * @return    false at the end of the log or on a truncated record.
+         */
+        bool next(Record& t_record);
+
+    private:
+        bool readVarint(uint64_t& t_value);
+        bool readString(std::string& t_value);
+
+        FILE*    m_file = nullptr;
+        uint64_t m_timeUs = 0;
+    };
+};
+
+} // namespace Plugin
+
+} // namespace WPEFramework
+#endif /* TRAFFICLOG_H */
@@ -18,10 +18,12 @@
 **/
 
 #include <algorithm>
+#include <chrono>
 #include <regex>
+#include <thread>
 #include "Module.h"
 #include "UnifiedCASManagement.h"
-#include "LibMediaPlayerImpl.h"
+#include "OutboundJson.h"
 
 #include "UtilsCStr.h"
 #include "UtilsJsonRpc.h"
@@ -34,7 +36,41 @@
 const string WPEFramework::Plugin::UnifiedCASManagement::METHOD_MANAGE = "manage";
 const string WPEFramework::Plugin::UnifiedCASManagement::METHOD_UNMANAGE = "unmanage";
 const string WPEFramework::Plugin::UnifiedCASManagement::METHOD_SEND = "send";
+const string WPEFramework::Plugin::UnifiedCASManagement::METHOD_OPENEVENTCHANNEL = "openEventChannel";
+const string WPEFramework::Plugin::UnifiedCASManagement::METHOD_CLOSEEVENTCHANNEL = "closeEventChannel";
+const string WPEFramework::Plugin::UnifiedCASManagement::METHOD_SETEVENTFILTER = "setEventFilter";
+const string WPEFramework::Plugin::UnifiedCASManagement::METHOD_CLEAREVENTFILTER = "clearEventFilter";
+const string WPEFramework::Plugin::UnifiedCASManagement::METHOD_GETSTATISTICS = "getStatistics";
+const string WPEFramework::Plugin::UnifiedCASManagement::METHOD_SENDBEGIN = "sendBegin";
+const string WPEFramework::Plugin::UnifiedCASManagement::METHOD_SENDCHUNK = "sendChunk";
+const string WPEFramework::Plugin::UnifiedCASManagement::METHOD_SENDEND = "sendEnd";
 const string WPEFramework::Plugin::UnifiedCASManagement::EVENT_DATA = "data";
+const string WPEFramework::Plugin::UnifiedCASManagement::EVENT_SESSIONCLOSED = "sessionclosed";
+const string WPEFramework::Plugin::UnifiedCASManagement::EVENT_DATABATCH = "databatch";
+const string WPEFramework::Plugin::UnifiedCASManagement::EVENT_SESSIONRECOVERING = "sessionrecovering";
+const string WPEFramework::Plugin::UnifiedCASManagement::EVENT_SESSIONRECOVERED = "sessionrecovered";
+const string WPEFramework::Plugin::UnifiedCASManagement::EVENT_SESSIONPREEMPTED = "sessionpreempted";
+const string WPEFramework::Plugin::UnifiedCASManagement::DEFAULT_BACKEND = "libmediaplayer";
+
+#define returnFailureResponse(reason, errorCode) \
+    { \
+        response["success"] = false; \
+        response["failurereason"] = static_cast<uint32_t>(reason); \
+        LOGTRACEMETHODFIN(); \
+        return (errorCode); \
+    }
+
+static std::string_view trimmed(const std::string& t_value)
+{
+    const char* whitespace = " \t\r\n";
+    std::size_t first = t_value.find_first_not_of(whitespace);
+    if (std::string::npos == first)
+    {
+        return std::string_view();
+    }
+    std::size_t last = t_value.find_last_not_of(whitespace);
+    return std::string_view(t_value).substr(first, last - first + 1);
+}
 
 namespace WPEFramework
 {
@@ -42,34 +78,206 @@ namespace WPEFramework
 namespace Plugin
 {
 
-UnifiedCASManagement* UnifiedCASManagement::_instance = nullptr;
+using JsonData::UnifiedCASManagement::ManageParamsData;
+using JsonData::UnifiedCASManagement::ModeType;
+using JsonData::UnifiedCASManagement::SendParamsData;
+using JsonData::UnifiedCASManagement::SendBeginParamsData;
+using JsonData::UnifiedCASManagement::SendChunkParamsData;
+using JsonData::UnifiedCASManagement::SendEndParamsData;
+
+// The hash only preselects; equal hashes of different parameters must not hand out another caller's session.
+static bool sameSessionParams(
+            const SessionSnapshot::Descriptor& t_session,
+            const std::string&                 t_mediaurl,
+            ManageMode                         t_manage,
+            const std::string&                 t_casinitdata,
+            const std::string&                 t_casocdmid)
+{
+    return ((t_manage == t_session.manage) &&
+            (trimmed(t_mediaurl) == trimmed(t_session.mediaurl)) &&
+            (trimmed(t_casinitdata) == trimmed(t_session.casinitdata)) &&
+            (trimmed(t_casocdmid) == trimmed(t_session.casocdmid)));
+}
 
 UnifiedCASManagement::UnifiedCASManagement()
+    : m_teardown(std::make_shared<TeardownState>())
+    , m_memory(std::make_shared<MemoryBudget>())
 {
+    m_teardown->owner = this;
 #ifdef LMPLAYER_FOUND
-    m_player = std::make_shared<LibMediaPlayerImpl>(this);
-#else
-    m_player = nullptr;
-    LOGERR("NO VALID PLAYER AVAILABLE TO USE");
+    m_libMediaPlayer = std::make_shared<LibMediaPlayerModule>(LibMediaPlayerModule::defaultPath());
+    m_playerRegistry.add(LibMediaPlayerModule::BACKEND_NAME, [module = m_libMediaPlayer](MediaPlayerObserver* t_observer) -> std::shared_ptr<MediaPlayer> {
+        return std::make_shared<LibMediaPlayerProxy>(t_observer, module);
+    });
 #endif
-    _instance = this;
+    for (std::string& backend : m_sessionBackends)
+    {
+        backend = m_defaultBackend;
+    }
+    replacePlayer();
     RegisterAll();
 }
 
 UnifiedCASManagement::~UnifiedCASManagement()
 {
+    {
+        // Teardowns still running from here on no longer report back to this instance.
+        std::lock_guard<std::mutex> lock(m_teardown->lock);
+        m_teardown->owner = nullptr;
+    }
+    joinTeardowns(true);
+    if (m_restoreThread.joinable())
+    {
+        m_restoreThread.join();
+    }
+    joinRecoveryThread();
+    m_eventBatcher.stop();
     UnregisterAll();
-    UnifiedCASManagement::_instance = nullptr;
 }
 
-const string UnifiedCASManagement::Initialize(PluginHost::IShell * /* service */)
+const string UnifiedCASManagement::Initialize(PluginHost::IShell * service)
 {
+    Config config;
+    if (nullptr != service)
+    {
+        config.FromString(service->ConfigLine());
+    }
+    m_deferredUnmanage = config.DeferredUnmanage.Value();
+    m_teardownTimeoutMs = config.TeardownTimeout.Value();
+    m_drainTimeoutMs = config.DrainTimeout.Value();
+    m_maxWaitTimeoutMs = config.MaxWaitTimeout.Value();
+    m_eventRingSize = config.EventRingSize.Value();
+    m_sendTimeoutMs = config.SendTimeout.Value();
+
+    std::vector<ResponseCache::Rule> cacheRules;
+    Core::JSON::ArrayType<CacheRuleConfig>::Iterator rule = config.ResponseCache.Rules.Elements();
+    while (rule.Next())
+    {
+        cacheRules.push_back({ rule.Current().Prefix.Value(), rule.Current().Ttl.Value() });
+    }
+    std::vector<std::string> cacheFlushOn;
+    Core::JSON::ArrayType<Core::JSON::String>::Iterator flushOn = config.ResponseCache.FlushOn.Elements();
+    while (flushOn.Next())
+    {
+        cacheFlushOn.push_back(flushOn.Current().Value());
+    }
+    m_responseCache.configure(std::move(cacheRules), std::move(cacheFlushOn));
+    m_psiCache.configure(config.PsiCache.Size.Value(), std::string(config.PsiCache.Prefix.Value()));
+    if (false == config.CaptureFile.Value().empty())
+    {
+        m_traffic.open(config.CaptureFile.Value(), config.CaptureMaxSize.Value());
+    }
+    m_sendThrottle.configure(config.SendRate.Value(), config.SendBurst.Value(), config.SendMaxInflight.Value());
+    m_chunkedSend.configure(config.MaxTransferSize.Value(), config.MaxTransfers.Value(), config.TransferTimeout.Value());
+    updateTransferUsage();
+    m_memory->configure(config.Memory.SoftLimit.Value(), config.Memory.HardLimit.Value());
+    m_sessionFootprint = config.Memory.SessionFootprint.Value();
+
+    m_transientErrors.clear();
+    Core::JSON::ArrayType<Core::JSON::DecSInt64>::Iterator transient = config.TransientErrors.Elements();
+    while (transient.Next())
+    {
+        m_transientErrors.insert(transient.Current().Value());
+    }
+    m_fatalErrors.clear();
+    Core::JSON::ArrayType<Core::JSON::DecSInt64>::Iterator fatal = config.FatalErrors.Elements();
+    while (fatal.Next())
+    {
+        m_fatalErrors.insert(fatal.Current().Value());
+    }
+    m_recoveryAttempts = config.RecoveryAttempts.Value();
+    m_recoveryBackoffMs = config.RecoveryBackoff.Value();
+    m_recoveryBackoffMaxMs = config.RecoveryBackoffMax.Value();
+    if (nullptr != m_libMediaPlayer)
+    {
+        m_libMediaPlayer->setUnloadDelay(config.PlayerUnloadDelay.Value());
+    }
+
+    if (config.PlayerBackend.IsSet())
+    {
+        m_defaultBackend = config.PlayerBackend.Value();
+    }
+    for (std::string& backend : m_sessionBackends)
+    {
+        backend = m_defaultBackend;
+    }
+    Core::JSON::ArrayType<BackendRuleConfig>::Iterator backendRule = config.Backends.Elements();
+    while (backendRule.Next())
+    {
+        if ((false == backendRule.Current().Manage.IsSet()) ||
+            (false == m_playerRegistry.contains(backendRule.Current().Backend.Value())))
+        {
+            LOGERR("Ignoring backend rule for unknown mode or backend '%s'", backendRule.Current().Backend.Value().c_str());
+            continue;
+        }
+        m_sessionBackends[static_cast<uint8_t>(backendRule.Current().Manage.Value())] = backendRule.Current().Backend.Value();
+    }
+
+    if (0 != config.BatchWindow.Value())
+    {
+        m_eventBatcher.start(config.BatchWindow.Value(), config.BatchSize.Value(),
+                             [this](std::vector<EventBatcher::Entry>&& batch) { event_databatch(std::move(batch)); });
+    }
+    LOGINFO("deferredunmanage = %d, teardowntimeout = %u ms, draintimeout = %u ms", m_deferredUnmanage, m_teardownTimeoutMs, m_drainTimeoutMs);
+
+    if ((nullptr != service) && (false == service->Callsign().empty()))
+    {
+        m_callsign = service->Callsign();
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_requestLock);
+        m_deactivating = false;
+    }
+    {
+        std::lock_guard<std::mutex> lock(m_sessionLock);
+        m_sessionDeactivating = false;
+        if (nullptr == m_player)
+        {
+            replacePlayer();
+        }
+    }
+
+    m_snapshot.configure(std::string(config.CasStatePrefix.Value()));
+    if ((nullptr != service) && (false == service->VolatilePath().empty()) &&
+        m_snapshot.open(service->VolatilePath() + "sessions.snapshot"))
+    {
+        SessionSnapshot::Descriptor session;
+        if (m_snapshot.load(session))
+        {
+            if (config.RestoreSessions.Value() && beginRequest())
+            {
+                // The restore counts as an in-flight request, so Deinitialize waits for it like for any other.
+                {
+                    std::lock_guard<std::mutex> lock(m_sessionLock);
+                    m_restoring = true;
+                }
+                LOGINFO("Restoring management session %u for %s", session.sessionId, session.mediaurl.c_str());
+                m_restoreThread = std::thread(&UnifiedCASManagement::restoreSession, this, std::move(session));
+            }
+            else
+            {
+                m_snapshot.clear();
+            }
+        }
+    }
     return (string());
 }
 
 void UnifiedCASManagement::Deinitialize(PluginHost::IShell * /* service */)
 {
-    UnifiedCASManagement::_instance = nullptr;
+    drainSessions();
+    m_eventBatcher.stop();
+    m_chunkedSend.clear();
+    updateTransferUsage();
+    m_traffic.close();
+    {
+        std::lock_guard<std::mutex> lock(m_eventChannelLock);
+        m_eventRing.close();
+        m_eventChannelOpens.clear();
+    }
+    // The record is kept, so the next activation can bring the session back.
+    m_snapshot.close();
 }
 
 string UnifiedCASManagement::Information() const
@@ -77,14 +285,218 @@ string UnifiedCASManagement::Information() const
     return (string());
 }
 
+std::size_t UnifiedCASManagement::hashManageParams(
+            const std::string& t_mediaurl,
+            ManageMode         t_manage,
+            const std::string& t_casinitdata,
+            const std::string& t_casocdmid)
+{
+    std::size_t seed = static_cast<std::size_t>(t_manage);
+    for (const std::string* field : { &t_mediaurl, &t_casinitdata, &t_casocdmid })
+    {
+        seed ^= std::hash<std::string_view>{}(trimmed(*field)) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+    }
+    return seed;
+}
+
+std::shared_ptr<MediaPlayer> UnifiedCASManagement::createPlayer()
+{
+    if (false == m_playerRegistry.contains(m_defaultBackend))
+    {
+        LOGERR("NO VALID PLAYER AVAILABLE TO USE");
+        return nullptr;
+    }
+    return m_playerRegistry.create(m_defaultBackend, this);
+}
+
+std::shared_ptr<MediaPlayer> UnifiedCASManagement::currentPlayer()
+{
+    std::lock_guard<std::mutex> lock(m_sessionLock);
+    return m_player;
+}
+
+void UnifiedCASManagement::replacePlayer()
+{
+    m_player = createPlayer();
+    m_playerBackend = m_defaultBackend;
+}
+
+void UnifiedCASManagement::teardownSession(
+     std::shared_ptr<TeardownState> t_state,
+     RetiredSession                 t_session)
+{
+    bool success = t_session.player->closeMediaPlayer();
+    if (false == success)
+    {
+        LOGERR("Teardown of session %u failed", t_session.sessionId);
+    }
+    // Dropping the player releases the native instance, and with it the tuner, before waiting manage calls resume.
+    t_session.player.reset();
+    t_session.memory->set(t_session.sessionId, MemoryBudget::CATEGORY_PLAYER, 0);
+
+    std::lock_guard<std::mutex> lock(t_state->lock);
+    if (nullptr != t_state->owner)
+    {
+        t_state->owner->event_sessionclosed(t_session.sessionId, success);
+    }
+    --t_state->pending;
+    if (t_session.tuned)
+    {
+        --t_state->pendingTuned;
+    }
+    t_state->finished.push_back(std::this_thread::get_id());
+    t_state->signal.notify_all();
+}
+
+void UnifiedCASManagement::retireSession(RetiredSession&& t_session)
+{
+    // A retired session is already closed for the client, so its late data events are not forwarded.
+    t_session.player->detachService();
+    joinTeardowns(false);
+
+    std::lock_guard<std::mutex> lock(m_teardown->lock);
+    ++m_teardown->pending;
+    if (t_session.tuned)
+    {
+        ++m_teardown->pendingTuned;
+    }
+    m_teardown->threads.emplace_back(&UnifiedCASManagement::teardownSession, m_teardown, std::move(t_session));
+}
+
+void UnifiedCASManagement::joinTeardowns(bool t_all)
+{
+    // Joined without holding the lock, as running teardowns take it on their way out.
+    std::list<std::thread> threads;
+    {
+        std::lock_guard<std::mutex> lock(m_teardown->lock);
+        std::list<std::thread>::iterator thread = m_teardown->threads.begin();
+        while (m_teardown->threads.end() != thread)
+        {
+            std::list<std::thread::id>::iterator finished = std::find(m_teardown->finished.begin(), m_teardown->finished.end(), thread->get_id());
+            if (m_teardown->finished.end() != finished)
+            {
+                m_teardown->finished.erase(finished);
+            }
+            else if (false == t_all)
+            {
+                ++thread;
+                continue;
+            }
+            threads.splice(threads.end(), m_teardown->threads, thread++);
+        }
+    }
+    for (std::thread& thread : threads)
+    {
+        thread.join();
+    }
+    if (t_all)
+    {
+        std::lock_guard<std::mutex> lock(m_teardown->lock);
+        m_teardown->finished.clear();
+    }
+}
+
+bool UnifiedCASManagement::waitForTunerRelease(uint32_t t_timeoutMs)
+{
+    std::unique_lock<std::mutex> lock(m_teardown->lock);
+    return m_teardown->signal.wait_for(lock, std::chrono::milliseconds(t_timeoutMs), [this] { return 0 == m_teardown->pendingTuned; });
+}
+
+bool UnifiedCASManagement::beginRequest()
+{
+    std::lock_guard<std::mutex> lock(m_requestLock);
+    if (m_deactivating)
+    {
+        return false;
+    }
+    ++m_inflightRequests;
+    return true;
+}
+
+void UnifiedCASManagement::endRequest()
+{
+    std::lock_guard<std::mutex> lock(m_requestLock);
+    --m_inflightRequests;
+    if (0 == m_inflightRequests)
+    {
+        m_requestsDone.notify_all();
+    }
+}
+
+void UnifiedCASManagement::drainSessions()
+{
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(m_drainTimeoutMs);
+
+    {
+        std::unique_lock<std::mutex> lock(m_requestLock);
+        m_deactivating = true;
+    }
+    cancelPendingReplies();
+    {
+        // A recovery waiting out its backoff and a manage request queued for the session give up right away instead of holding the drain.
+        std::lock_guard<std::mutex> lock(m_sessionLock);
+        m_sessionDeactivating = true;
+    }
+    m_recoveryCancel.notify_all();
+    m_sessionSettled.notify_all();
+    {
+        std::unique_lock<std::mutex> lock(m_requestLock);
+        if (false == m_requestsDone.wait_until(lock, deadline, [this] { return 0 == m_inflightRequests; }))
+        {
+            LOGWARN("%u requests still in flight at deactivation", m_inflightRequests);
+        }
+    }
+
+    if (m_restoreThread.joinable())
+    {
+        m_restoreThread.join();
+    }
+    joinRecoveryThread();
+
+    {
+        std::lock_guard<std::mutex> lock(m_sessionLock);
+        if (m_sessionActive && (nullptr != m_player))
+        {
+            retireSession({ m_player, m_sessionId, m_sessionTuned, m_memory });
+            m_sessionActive = false;
+            m_sessionRestored = false;
+            m_scheduler.release();
+        }
+        m_player.reset();
+    }
+
+    // Active and deferred sessions are all closing on their own threads by now, so they drain in parallel.
+    std::unique_lock<std::mutex> lock(m_teardown->lock);
+    if (false == m_teardown->signal.wait_until(lock, deadline, [this] { return 0 == m_teardown->pending; }))
+    {
+        LOGERR("%u sessions still tearing down after %u ms", m_teardown->pending, m_drainTimeoutMs);
+        // Their sessionclosed events would arrive after deactivation, so they are dropped.
+        m_teardown->owner = nullptr;
+    }
+    lock.unlock();
+
+    // The threads run plugin code, so none of them may outlive Deinitialize and the library being unloaded.
+    joinTeardowns(true);
+    lock.lock();
+    m_teardown->owner = this;
+}
+
 //Registration
 SERVICE_REGISTRATION(UnifiedCASManagement, 1, 0);
 
 void UnifiedCASManagement::RegisterAll()
 {
-    Register(METHOD_MANAGE, &UnifiedCASManagement::manage, this);
+    Register<JsonData::UnifiedCASManagement::ManageParamsData, JsonObject>(METHOD_MANAGE, &UnifiedCASManagement::manage, this);
     Register(METHOD_UNMANAGE, &UnifiedCASManagement::unmanage, this);
-    Register(METHOD_SEND, &UnifiedCASManagement::send, this);
+    Register<JsonData::UnifiedCASManagement::SendParamsData, JsonObject>(METHOD_SEND, &UnifiedCASManagement::send, this);
+    Register<JsonObject, JsonObject>(METHOD_OPENEVENTCHANNEL, &UnifiedCASManagement::openEventChannel, this);
+    Register<JsonObject, JsonObject>(METHOD_CLOSEEVENTCHANNEL, &UnifiedCASManagement::closeEventChannel, this);
+    Register<JsonObject, JsonObject>(METHOD_SETEVENTFILTER, &UnifiedCASManagement::setEventFilter, this);
+    Register<JsonObject, JsonObject>(METHOD_CLEAREVENTFILTER, &UnifiedCASManagement::clearEventFilter, this);
+    Register(METHOD_GETSTATISTICS, &UnifiedCASManagement::getStatistics, this);
+    Register<JsonData::UnifiedCASManagement::SendBeginParamsData, JsonObject>(METHOD_SENDBEGIN, &UnifiedCASManagement::sendBegin, this);
+    Register<JsonData::UnifiedCASManagement::SendChunkParamsData, JsonObject>(METHOD_SENDCHUNK, &UnifiedCASManagement::sendChunk, this);
+    Register<JsonData::UnifiedCASManagement::SendEndParamsData, JsonObject>(METHOD_SENDEND, &UnifiedCASManagement::sendEnd, this);
 }
 
 void UnifiedCASManagement::UnregisterAll()
@@ -92,39 +504,48 @@ void UnifiedCASManagement::UnregisterAll()
     Unregister(METHOD_MANAGE);
     Unregister(METHOD_UNMANAGE);
     Unregister(METHOD_SEND);
+    Unregister(METHOD_OPENEVENTCHANNEL);
+    Unregister(METHOD_CLOSEEVENTCHANNEL);
+    Unregister(METHOD_SETEVENTFILTER);
+    Unregister(METHOD_CLEAREVENTFILTER);
+    Unregister(METHOD_GETSTATISTICS);
+    Unregister(METHOD_SENDBEGIN);
+    Unregister(METHOD_SENDCHUNK);
+    Unregister(METHOD_SENDEND);
 }
 
 // API implementation
 
 // Method: manage - Manage a well-known CAS
 // Return codes:
-//  - ERROR_NONE: Success
-uint32_t UnifiedCASManagement::manage(const JsonObject& params, JsonObject& response)
+//  - ERROR_NONE: Success, or an active session with the same parameters was returned
+//  - ERROR_ALREADY_CONNECTED: A session with different parameters is already active
+//  - ERROR_TIMEDOUT: A deferred teardown still holds the tuner
+//  - ERROR_UNAVAILABLE: The plugin is deactivating
+uint32_t UnifiedCASManagement::manage(const ManageParamsData& params, JsonObject& response)
 {
     bool success = false;
 
-    if(nullptr == m_player)
+    RequestScope scope(*this);
+    if(false == scope.admitted())
     {
-        LOGERR("NO VALID PLAYER AVAILABLE TO USE");
-        returnResponse(success);
+        LOGERR("Plugin is deactivating");
+        returnFailureResponse(FAILURE_DEACTIVATING, Core::ERROR_UNAVAILABLE);
     }
+    captureCall(TrafficLog::Kind::MANAGE, 0, params);
 
-    returnIfStringParamNotFound(params, "mode");
-    returnIfStringParamNotFound(params, "manage");
-
-    const std::string& mediaurl = params["mediaurl"].String();
-    const std::string& mode = params["mode"].String();
-    const std::string& manage = params["manage"].String();
-    const std::string& casinitdata = params["casinitdata"].String();
-    const std::string& casocdmid = params["casocdmid"].String();
+    const std::string& mediaurl = params.Mediaurl.Value();
+    const std::string& casinitdata = params.Casinitdata.Value();
+    const std::string& casocdmid = params.Casocdmid.Value();
 
     LOGINFO("media URL:%s, ocdmid = %s", mediaurl.c_str(), casocdmid.c_str());
 
-    if(mode != "MODE_NONE")
+    // Unknown enum values are rejected by the parser and leave the field unset.
+    if((false == params.Mode.IsSet()) || (ModeType::MODE_NONE != params.Mode.Value()))
     {
         LOGERR("mode must be MODE_NONE for CAS Management");
     }
-    else if (manage != "MANAGE_FULL" && manage != "MANAGE_NO_PSI" && manage != "MANAGE_NO_TUNER")
+    else if (false == params.Manage.IsSet())
     {
         LOGERR("manage must be MANAGE_ ... FULL, NO_PSI or NO_TUNER for CAS MAnagement");
     }
@@ -132,6 +553,10 @@ uint32_t UnifiedCASManagement::manage(const JsonObject& params, JsonObject& resp
     {
         LOGERR("ocdmcasid is mandatory for CAS management session");
     }
+    else if(params.Waittimeout.Value() > m_maxWaitTimeoutMs)
+    {
+        LOGERR("waittimeout %u ms exceeds maxwaittimeout %u ms", params.Waittimeout.Value(), m_maxWaitTimeoutMs);
+    }
     else
     {
         success = true;
@@ -140,97 +565,1178 @@ uint32_t UnifiedCASManagement::manage(const JsonObject& params, JsonObject& resp
     if(success == false)
     {
         LOGERR("UnifiedCASManagement Open Session Failed");
+        returnResponse(success);
     }
-    else
+
+    std::unique_lock<std::mutex> lock(m_sessionLock);
+    m_sessionSettled.wait(lock, [this] { return (false == m_restoring) && (false == m_recovering); });
+
+    const ManageMode manageMode = params.Manage.Value();
+    const std::size_t paramsHash = hashManageParams(mediaurl, manageMode, casinitdata, casocdmid);
+    const SessionPriority priority = params.Priority.IsSet() ? JsonData::UnifiedCASManagement::toSessionPriority(params.Priority.Value()) : SessionPriority::PRIORITY_LIVE;
+
+    if(m_sessionActive && (paramsHash == m_sessionHash) &&
+       sameSessionParams(m_sessionDescriptor, mediaurl, manageMode, casinitdata, casocdmid))
     {
-        JsonObject jsonParams;
-        jsonParams["mediaurl"] = mediaurl;
-        jsonParams["mode"] = mode;
-        jsonParams["manage"] = manage;
-        jsonParams["casinitdata"] = casinitdata;
-        jsonParams["casocdmid"] = casocdmid;
+        LOGINFO("Reusing active management session %u", m_sessionId);
+        response["sessionid"] = m_sessionId;
+        if(m_sessionRestored)
+        {
+            response["restored"] = true;
+            response["casstate"] = m_restoredCasState;
+        }
+        returnResponse(success);
+    }
 
-        std::string openParams;
-        jsonParams.ToString(openParams);
-        LOGINFO("OpenData = %s\n", openParams.c_str());
+    if(MemoryBudget::LEVEL_HARD == m_memory->level())
+    {
+        LOGERR("Refusing a new session, %zu bytes held reach the memory hard limit", m_memory->used());
+        m_memory->countSessionRefused();
+        returnFailureResponse(FAILURE_MEMORY_LIMITED, Core::ERROR_INPROGRESS);
+    }
 
-        if (false == m_player->openMediaPlayer(openParams, manage))
+    if(false == scheduleSessionLocked(lock, priority, params.Waittimeout.Value()))
+    {
+        if(m_sessionDeactivating)
         {
-            LOGERR("Failed to open MediaPlayer");
-            success = false;
+            returnFailureResponse(FAILURE_DEACTIVATING, Core::ERROR_UNAVAILABLE);
         }
+        LOGERR("The session is held or claimed by a request of the same or higher priority");
+        response["expectedwait"] = m_scheduler.expectedWaitMs(priority);
+        returnFailureResponse(FAILURE_SESSION_CONFLICT, Core::ERROR_ALREADY_CONNECTED);
+    }
+
+    const bool tuned = usesTuner(manageMode);
+    if(tuned && (false == waitForTunerRelease(m_teardownTimeoutMs)))
+    {
+        LOGERR("Deferred teardown did not release the tuner within %u ms", m_teardownTimeoutMs);
+        returnFailureResponse(FAILURE_TUNER_BUSY, Core::ERROR_TIMEDOUT);
+    }
+
+    SessionSnapshot::Descriptor session;
+    session.sessionId = m_sessionId + 1;
+    session.manage = manageMode;
+    session.mediaurl = mediaurl;
+    session.casinitdata = casinitdata;
+    session.casocdmid = casocdmid;
+
+    success = openSessionLocked(session, paramsHash);
+    if (success)
+    {
+        m_scheduler.acquire(priority);
+        response["sessionid"] = m_sessionId;
     }
+    // A queued request behind this one may now take the free slot or pre-empt the new session.
+    m_sessionSettled.notify_all();
     returnResponse(success);
 }
 
-// Method: unmanage - Destroy a management session
-// Return codes:
-//  - ERROR_NONE: Success
-uint32_t UnifiedCASManagement::unmanage(const JsonObject& params, JsonObject& response)
+bool UnifiedCASManagement::scheduleSessionLocked(std::unique_lock<std::mutex>& t_lock, SessionPriority t_priority, uint32_t t_waitMs)
 {
-    bool success = false;
+    if (m_sessionActive ? m_scheduler.preempts(t_priority) : m_scheduler.admits(t_priority))
+    {
+        if (m_sessionActive)
+        {
+            preemptSessionLocked(t_priority);
+        }
+        return true;
+    }
+    if (0 == t_waitMs)
+    {
+        return false;
+    }
 
-    if(nullptr == m_player)
+    const SessionScheduler::Ticket ticket = m_scheduler.enqueue(t_priority);
+    const bool admitted = m_sessionSettled.wait_for(t_lock, std::chrono::milliseconds(t_waitMs), [this, ticket, t_priority] {
+        // Deactivation gives up the wait; restores and recoveries are let finish first.
+        return m_sessionDeactivating ||
+               ((false == m_restoring) && (false == m_recovering) &&
+                (m_sessionActive ? m_scheduler.preempts(t_priority) : m_scheduler.isNext(ticket)));
+    }) && (false == m_sessionDeactivating);
+    m_scheduler.dequeue(ticket);
+    // The next queued request may be the one to go now.
+    m_sessionSettled.notify_all();
+
+    if (false == admitted)
+    {
+        m_scheduler.countWaitTimeout();
+        return false;
+    }
+    if (m_sessionActive)
+    {
+        preemptSessionLocked(t_priority);
+    }
+    return true;
+}
+
+void UnifiedCASManagement::preemptSessionLocked(SessionPriority t_priority)
+{
+    const uint32_t sessionId = m_sessionId;
+    LOGWARN("Pre-empting management session %u for a request of higher priority", sessionId);
+    // Torn down like a deferred unmanage; a tuned request then waits for the tuner as usual.
+    retireSession({ m_player, m_sessionId, m_sessionTuned, m_memory });
+    replacePlayer();
+    m_sessionActive = false;
+    m_sessionRestored = false;
+    m_snapshot.clear();
+    m_scheduler.release(true);
+    event_sessionpreempted(sessionId, t_priority);
+}
+
+bool UnifiedCASManagement::openSessionLocked(const SessionSnapshot::Descriptor& t_session, std::size_t t_hash)
+{
+    // Only MANAGE_FULL sessions acquire PSI; with it cached, the stack can descramble before fresh PSI arrives.
+    PsiCache::Entry psi;
+    const bool psiCached = (ManageMode::MANAGE_FULL == t_session.manage) &&
+                           m_psiCache.open(t_session.sessionId, std::string(trimmed(t_session.mediaurl)), psi);
+    const OutboundJson::Field fields[] = {
+        { "mediaurl", t_session.mediaurl },
+        { "mode", "MODE_NONE" },
+        { "manage", manageModeEntry(t_session.manage).name },
+        { "casinitdata", t_session.casinitdata },
+        { "casocdmid", t_session.casocdmid },
+        { "psi", psi.psi },
+        { "psiversion", psi.version }
+    };
+    std::string openParams = OutboundJson::serialize(fields, sizeof(fields) / sizeof(fields[0]) - (psiCached ? 0 : 2));
+    LOGINFO("OpenData = %s\n", openParams.c_str());
+
+    // No session is open here, so the idle player can be swapped for the backend configured for this mode.
+    const std::string& backend = m_sessionBackends[static_cast<uint8_t>(t_session.manage)];
+    if (backend != m_playerBackend)
+    {
+        std::shared_ptr<MediaPlayer> player = m_playerRegistry.create(backend, this);
+        if (nullptr == player)
+        {
+            return false;
+        }
+        LOGINFO("Switching player backend from '%s' to '%s'", m_playerBackend.c_str(), backend.c_str());
+        m_player = std::move(player);
+        m_playerBackend = backend;
+    }
+    if (nullptr == m_player)
     {
         LOGERR("NO VALID PLAYER AVAILABLE TO USE");
-        returnResponse(success);
+        return false;
     }
 
-    if (false == m_player->closeMediaPlayer())
+    m_player->setSessionId(t_session.sessionId);
+    MemoryBudget::Charge request(*m_memory, t_session.sessionId, MemoryBudget::CATEGORY_REQUESTS, openParams.capacity());
+    if (false == m_player->openMediaPlayer(openParams, t_session.manage))
     {
-         LOGERR("Failed to close MediaPlayer");
-         LOGWARN("Error in destroying CAS Management Session...\n");
+        LOGERR("Failed to open MediaPlayer");
+        return false;
+    }
+    // Charged again on a rebuild of the same session, so set rather than added.
+    m_memory->set(t_session.sessionId, MemoryBudget::CATEGORY_PLAYER, m_sessionFootprint);
+    if (ManageMode::MANAGE_FULL == t_session.manage)
+    {
+        m_psiCache.confirm(t_session.sessionId);
+    }
+
+    m_sessionActive = true;
+    m_sessionTuned = usesTuner(t_session.manage);
+    m_sessionHash = t_hash;
+    m_sessionId = t_session.sessionId;
+    m_sessionRestored = false;
+    m_sessionDescriptor = t_session;
+    m_snapshot.store(t_session);
+    return true;
+}
+
+void UnifiedCASManagement::restoreSession(SessionSnapshot::Descriptor t_session)
+{
+    std::unique_lock<std::mutex> lock(m_sessionLock);
+
+    if ((false == m_sessionActive) &&
+        ((false == usesTuner(t_session.manage)) || waitForTunerRelease(m_teardownTimeoutMs)) &&
+        openSessionLocked(t_session, hashManageParams(t_session.mediaurl, t_session.manage, t_session.casinitdata, t_session.casocdmid)))
+    {
+        LOGINFO("Management session %u restored", t_session.sessionId);
+        m_scheduler.acquire(SessionPriority::PRIORITY_LIVE);
+        m_sessionRestored = true;
+        m_restoredCasState = std::move(t_session.casState);
     }
     else
     {
-         LOGINFO("Successful in destroying CAS Management Session...\n");
-         success = true;
+        LOGERR("Failed to restore management session %u", t_session.sessionId);
+        m_snapshot.clear();
     }
-    returnResponse(success);
+
+    m_restoring = false;
+    lock.unlock();
+    m_sessionSettled.notify_all();
+    endRequest();
 }
 
-// Method: send - Sends data to the remote CAS
-// Return codes:
-//  - ERROR_NONE: Success
-uint32_t UnifiedCASManagement::send(const JsonObject& params, JsonObject& response)
+void UnifiedCASManagement::onPlayerError(int64_t t_code, uint32_t t_sessionId)
 {
-    bool success = false;
+    if (m_traffic.active())
+    {
+        m_traffic.record(TrafficLog::Kind::PLAYER_ERROR, t_sessionId, std::string(), std::string(), t_code);
+    }
 
-    if(nullptr == m_player)
+    const bool fatal = (m_fatalErrors.end() != m_fatalErrors.find(t_code));
+    if ((false == fatal) && (m_transientErrors.end() == m_transientErrors.find(t_code)))
     {
-        LOGERR("NO VALID PLAYER AVAILABLE TO USE");
-        returnResponse(success);
+        return;
     }
 
-    const std::string& payload = params["payload"].String();
-    const std::string& source = params["source"].String();
-    JsonObject jsonParams;
-    jsonParams["payload"] = payload;
-    jsonParams["source"] = source;
+    std::lock_guard<std::mutex> lock(m_recoveryThreadLock);
+    if (m_recoveryThreadBusy)
+    {
+        // The session is already being rebuilt or closed; follow-up errors of the same failure are absorbed.
+        LOGWARN("Player error %lld on session %u ignored, recovery in progress", static_cast<long long>(t_code), t_sessionId);
+        return;
+    }
+    // Like the restore, error handling counts as an in-flight request, so Deinitialize waits for it.
+    if (false == beginRequest())
+    {
+        return;
+    }
+    if (m_recoveryThread.joinable())
+    {
+        m_recoveryThread.join();
+    }
+    m_recoveryThreadBusy = true;
+    m_recoveryThread = std::thread(&UnifiedCASManagement::handlePlayerError, this, t_code, t_sessionId, fatal, std::chrono::steady_clock::now());
+}
 
-    std::string data;
-    jsonParams.ToString(data);
-    LOGINFO("Send Data = %s\n", data.c_str());
+void UnifiedCASManagement::handlePlayerError(int64_t t_code, uint32_t t_sessionId, bool t_fatal, std::chrono::steady_clock::time_point t_reported)
+{
+    std::unique_lock<std::mutex> lock(m_sessionLock);
+    m_sessionSettled.wait(lock, [this] { return false == m_restoring; });
 
-    if (false == m_player->requestCASData(data))
+    if ((false == m_sessionActive) || (t_sessionId != m_sessionId) || (nullptr == m_player) || m_sessionDeactivating)
     {
-        LOGERR("requestCASData failed");
+        LOGINFO("Player error %lld reported for session %u, which is no longer active", static_cast<long long>(t_code), t_sessionId);
+    }
+    else if (t_fatal)
+    {
+        LOGERR("Fatal player error %lld, closing management session %u", static_cast<long long>(t_code), t_sessionId);
+        retireSession({ m_player, m_sessionId, m_sessionTuned, m_memory });
+        replacePlayer();
+        m_sessionActive = false;
+        m_sessionRestored = false;
+        m_scheduler.release();
+        m_snapshot.clear();
     }
     else
     {
-        LOGINFO("UnifiedCASManagement send Data succeeded.. Calling Play\n");
-        success = true;
+        LOGWARN("Transient player error %lld, rebuilding management session %u", static_cast<long long>(t_code), t_sessionId);
+        m_recovering = true;
+        ++m_recoveriesStarted;
+        lock.unlock();
+        event_sessionrecovering(t_sessionId, t_code);
+        lock.lock();
+
+        uint32_t attempts = 0;
+        if (recoverSessionLocked(lock, attempts))
+        {
+            const uint32_t elapsedMs = static_cast<uint32_t>(std::chrono::duration_cast<std::chrono::milliseconds>(
+                                           std::chrono::steady_clock::now() - t_reported).count());
+            LOGINFO("Management session %u recovered after %u attempts in %u ms", t_sessionId, attempts, elapsedMs);
+            ++m_recoveriesSucceeded;
+            m_lastRecoveryMs = elapsedMs;
+            if (elapsedMs > m_maxRecoveryMs)
+            {
+                m_maxRecoveryMs = elapsedMs;
+            }
+            lock.unlock();
+            event_sessionrecovered(t_sessionId, attempts, elapsedMs);
+            lock.lock();
+        }
+        else
+        {
+            LOGERR("Giving up management session %u after %u recovery attempts", t_sessionId, attempts);
+            ++m_recoveriesFailed;
+            m_memory->set(t_sessionId, MemoryBudget::CATEGORY_PLAYER, 0);
+            m_sessionActive = false;
+            m_sessionRestored = false;
+            m_scheduler.release();
+            // On deactivation the record is kept, so the next activation can still bring the session back.
+            if (false == m_sessionDeactivating)
+            {
+                m_snapshot.clear();
+            }
+            lock.unlock();
+            event_sessionclosed(t_sessionId, false);
+            lock.lock();
+        }
+        m_recovering = false;
     }
-    returnResponse(success);
+    lock.unlock();
+    m_sessionSettled.notify_all();
+
+    {
+        std::lock_guard<std::mutex> threadLock(m_recoveryThreadLock);
+        m_recoveryThreadBusy = false;
+    }
+    endRequest();
 }
 
-// Event: data - Sent when the CAS needs to send data to the caller
-void UnifiedCASManagement::event_data(const std::string& payload, const std::string& source)
+void UnifiedCASManagement::updateTransferUsage()
+{
+    // Uploads belong to client connections rather than sessions.
+    m_memory->set(MemoryBudget::SHARED_SESSION, MemoryBudget::CATEGORY_TRANSFERS, m_chunkedSend.reserved());
+}
+
+void UnifiedCASManagement::joinRecoveryThread()
+{
+    // The thread takes m_recoveryThreadLock on its way out, so it is joined without holding the lock.
+    std::thread recoveryThread;
+    {
+        std::lock_guard<std::mutex> lock(m_recoveryThreadLock);
+        recoveryThread = std::move(m_recoveryThread);
+    }
+    if (recoveryThread.joinable())
+    {
+        recoveryThread.join();
+    }
+}
+
+bool UnifiedCASManagement::recoverSessionLocked(std::unique_lock<std::mutex>& t_lock, uint32_t& t_attempts)
+{
+    uint32_t backoffMs = m_recoveryBackoffMs;
+    for (t_attempts = 1; t_attempts <= m_recoveryAttempts; ++t_attempts)
+    {
+        if (t_attempts > 1)
+        {
+            if (m_recoveryCancel.wait_for(t_lock, std::chrono::milliseconds(backoffMs), [this] { return m_sessionDeactivating; }))
+            {
+                --t_attempts;
+                return false;
+            }
+            backoffMs = std::min(backoffMs * 2, m_recoveryBackoffMaxMs);
+        }
+        m_player->closeMediaPlayer();
+        if (openSessionLocked(m_sessionDescriptor, m_sessionHash))
+        {
+            return true;
+        }
+        LOGWARN("Recovery attempt %u of session %u failed", t_attempts, m_sessionDescriptor.sessionId);
+    }
+    t_attempts = m_recoveryAttempts;
+    return false;
+}
+
+// Method: unmanage - Destroy a management session
+// Return codes:
+//  - ERROR_NONE: Success, or the session was handed over for deferred teardown
+//  - ERROR_UNAVAILABLE: The plugin is deactivating
+uint32_t UnifiedCASManagement::unmanage(const JsonObject& params, JsonObject& response)
+{
+    bool success = false;
+
+    RequestScope scope(*this);
+    if(false == scope.admitted())
+    {
+        LOGERR("Plugin is deactivating");
+        returnFailureResponse(FAILURE_DEACTIVATING, Core::ERROR_UNAVAILABLE);
+    }
+    captureCall(TrafficLog::Kind::UNMANAGE, 0, params);
+
+    bool deferred = m_deferredUnmanage;
+    if (params.HasLabel("deferred") && (Core::JSON::Variant::type::BOOLEAN == params["deferred"].Content()))
+    {
+        deferred = params["deferred"].Boolean();
+    }
+
+    std::unique_lock<std::mutex> lock(m_sessionLock);
+    m_sessionSettled.wait(lock, [this] { return (false == m_restoring) && (false == m_recovering); });
+
+    if(nullptr == m_player)
+    {
+        LOGERR("NO VALID PLAYER AVAILABLE TO USE");
+        returnResponse(success);
+    }
+
+    if (deferred && m_sessionActive)
+    {
+        retireSession({ m_player, m_sessionId, m_sessionTuned, m_memory });
+        replacePlayer();
+        m_sessionActive = false;
+        m_sessionRestored = false;
+        m_scheduler.release();
+        m_snapshot.clear();
+        m_sessionSettled.notify_all();
+        LOGINFO("CAS Management Session %u handed over for deferred teardown", m_sessionId);
+        response["sessionid"] = m_sessionId;
+        returnResponse(true);
+    }
+
+    if (false == m_player->closeMediaPlayer())
+    {
+         LOGERR("Failed to close MediaPlayer");
+         LOGWARN("Error in destroying CAS Management Session...\n");
+    }
+    else
+    {
+         LOGINFO("Successful in destroying CAS Management Session...\n");
+         m_snapshot.clear();
+         m_memory->set(m_sessionId, MemoryBudget::CATEGORY_PLAYER, 0);
+         if (m_sessionActive)
+         {
+             m_sessionActive = false;
+             m_sessionRestored = false;
+             m_scheduler.release();
+             m_sessionSettled.notify_all();
+             event_sessionclosed(m_sessionId, true);
+         }
+         success = true;
+    }
+    returnResponse(success);
+}
+
+// Method: send - Sends data to the remote CAS
+// Return codes:
+//  - ERROR_NONE: Success
+//  - ERROR_TIMEDOUT: No reply to an awaited send arrived in time
+//  - ERROR_UNAVAILABLE: The plugin is deactivating
+uint32_t UnifiedCASManagement::send(const Core::JSONRPC::Context& context, const SendParamsData& params, JsonObject& response)
+{
+    bool success = false;
+
+    RequestScope scope(*this);
+    if(false == scope.admitted())
+    {
+        LOGERR("Plugin is deactivating");
+        returnFailureResponse(FAILURE_DEACTIVATING, Core::ERROR_UNAVAILABLE);
+    }
+    captureCall(TrafficLog::Kind::SEND, context.ChannelId(), params);
+
+    SendThrottle::Ticket ticket(m_sendThrottle, context.ChannelId());
+    switch (ticket.admission())
+    {
+        case SendThrottle::RATE_LIMITED:
+            LOGWARN("Channel %u exceeded its send rate", context.ChannelId());
+            returnFailureResponse(FAILURE_RATE_LIMITED, Core::ERROR_INPROGRESS);
+        case SendThrottle::INFLIGHT_LIMITED:
+            LOGWARN("Channel %u has too many sends in flight", context.ChannelId());
+            returnFailureResponse(FAILURE_INFLIGHT_LIMITED, Core::ERROR_INPROGRESS);
+        case SendThrottle::CLIENTS_LIMITED:
+            LOGWARN("Channel %u refused, %u other clients are sending", context.ChannelId(), SendThrottle::MAX_CLIENTS);
+            returnFailureResponse(FAILURE_CLIENTS_LIMITED, Core::ERROR_INPROGRESS);
+        case SendThrottle::ADMITTED:
+            break;
+    }
+
+    // The session may be retired or swapped meanwhile; this copy keeps the player alive until the send is done.
+    const std::shared_ptr<MediaPlayer> player = currentPlayer();
+    if(nullptr == player)
+    {
+        LOGERR("NO VALID PLAYER AVAILABLE TO USE");
+        returnResponse(success);
+    }
+
+    const bool awaitResponse = params.Awaitresponse.Value();
+    PendingReply reply;
+    reply.sessionId = player->sessionId();
+
+    if (awaitResponse && m_responseCache.lookup(params.Payload.Value(), params.Source.Value(), reply.sessionId, reply.payload, reply.source))
+    {
+        LOGINFO("Serving send from the response cache");
+        response["payload"] = reply.payload;
+        response["source"] = reply.source;
+        response["cached"] = true;
+        returnResponse(true);
+    }
+
+    if (awaitResponse)
+    {
+        // Registered before the request goes out, the CAS may answer from within requestCASData.
+        std::lock_guard<std::mutex> lock(m_replyLock);
+        reply.requestId = ++m_nextRequestId;
+        m_pendingReplies.push_back(&reply);
+    }
+
+    // Written straight into one string; requestid is only sent with awaited sends.
+    const OutboundJson::Field fields[] = {
+        { "payload", params.Payload.Value() },
+        { "source", params.Source.Value() },
+        { "requestid", reply.requestId }
+    };
+    std::string data = OutboundJson::serialize(fields, awaitResponse ? 3 : 2);
+    LOGINFO("Send Data = %s\n", data.c_str());
+    MemoryBudget::Charge request(*m_memory, reply.sessionId, MemoryBudget::CATEGORY_REQUESTS, data.capacity());
+
+    if (false == player->requestCASData(data))
+    {
+        LOGERR("requestCASData failed");
+    }
+    else
+    {
+        LOGINFO("UnifiedCASManagement send Data succeeded.. Calling Play\n");
+        success = true;
+    }
+
+    if (false == awaitResponse)
+    {
+        returnResponse(success);
+    }
+
+    std::unique_lock<std::mutex> lock(m_replyLock);
+    if (success)
+    {
+        const uint32_t timeoutMs = params.Timeout.IsSet() ? params.Timeout.Value() : m_sendTimeoutMs;
+        m_replySignal.wait_for(lock, std::chrono::milliseconds(timeoutMs), [&reply] { return reply.done || reply.cancelled; });
+    }
+    if (false == reply.done)
+    {
+        m_pendingReplies.remove(&reply);
+    }
+    lock.unlock();
+
+    if (false == success)
+    {
+        returnResponse(success);
+    }
+    if (reply.cancelled)
+    {
+        LOGERR("Plugin is deactivating, dropping awaited send %u", reply.requestId);
+        returnFailureResponse(FAILURE_DEACTIVATING, Core::ERROR_UNAVAILABLE);
+    }
+    if (false == reply.done)
+    {
+        LOGERR("No reply to send %u from the CAS", reply.requestId);
+        returnFailureResponse(FAILURE_REPLY_TIMEOUT, Core::ERROR_TIMEDOUT);
+    }
+    m_responseCache.store(params.Payload.Value(), params.Source.Value(), reply.sessionId, reply.payload, reply.source);
+    response["payload"] = reply.payload;
+    response["source"] = reply.source;
+    returnResponse(success);
+}
+
+// Method: sendBegin - Starts a chunked upload of a large payload
+// Return codes:
+//  - ERROR_NONE: Success
+//  - ERROR_INVALID_INPUT_LENGTH: The size exceeds maxtransfersize
+//  - ERROR_INPROGRESS: maxtransfers uploads are in progress
+//  - ERROR_UNAVAILABLE: The plugin is deactivating
+uint32_t UnifiedCASManagement::sendBegin(const Core::JSONRPC::Context& context, const SendBeginParamsData& params, JsonObject& response)
+{
+    RequestScope scope(*this);
+    if(false == scope.admitted())
+    {
+        LOGERR("Plugin is deactivating");
+        returnFailureResponse(FAILURE_DEACTIVATING, Core::ERROR_UNAVAILABLE);
+    }
+    captureCall(TrafficLog::Kind::SEND_BEGIN, context.ChannelId(), params);
+
+    // The buffer is reserved for the whole payload at once, so bulk uploads are the first load to shed.
+    if(MemoryBudget::LEVEL_NORMAL != m_memory->level())
+    {
+        LOGWARN("Refusing chunked upload of %u bytes, %zu bytes held reach the memory soft limit", params.Size.Value(), m_memory->used());
+        m_memory->countTransferRejected();
+        returnFailureResponse(FAILURE_MEMORY_LIMITED, Core::ERROR_INPROGRESS);
+    }
+
+    uint32_t transferId = 0;
+    const ChunkedSend::Status status = m_chunkedSend.begin(context.ChannelId(), params.Size.Value(), params.Source.Value(), transferId);
+    updateTransferUsage();
+    switch (status)
+    {
+        case ChunkedSend::TOO_LARGE:
+            LOGERR("Chunked upload of %u bytes exceeds the configured maximum", params.Size.Value());
+            returnFailureResponse(FAILURE_TRANSFER_REJECTED, Core::ERROR_INVALID_INPUT_LENGTH);
+        case ChunkedSend::TOO_MANY:
+            LOGWARN("Too many chunked uploads in progress");
+            returnFailureResponse(FAILURE_TRANSFER_REJECTED, Core::ERROR_INPROGRESS);
+        default:
+            break;
+    }
+
+    LOGINFO("Chunked upload %u of %u bytes started", transferId, params.Size.Value());
+    response["transferid"] = transferId;
+    returnResponse(true);
+}
+
+// Method: sendChunk - Appends the next part of the payload to a chunked upload
+// Return codes:
+//  - ERROR_NONE: Success
+//  - ERROR_UNKNOWN_KEY: No such upload on this connection
+//  - ERROR_INVALID_RANGE: The offset is not the number of bytes received so far
+//  - ERROR_INVALID_INPUT_LENGTH: The chunk exceeds the declared size
+//  - ERROR_UNAVAILABLE: The plugin is deactivating
+uint32_t UnifiedCASManagement::sendChunk(const Core::JSONRPC::Context& context, const SendChunkParamsData& params, JsonObject& response)
+{
+    RequestScope scope(*this);
+    if(false == scope.admitted())
+    {
+        LOGERR("Plugin is deactivating");
+        returnFailureResponse(FAILURE_DEACTIVATING, Core::ERROR_UNAVAILABLE);
+    }
+    captureCall(TrafficLog::Kind::SEND_CHUNK, context.ChannelId(), params);
+
+    const uint32_t transferId = params.Transferid.Value();
+    const uint32_t offset = params.Offset.IsSet() ? params.Offset.Value() : ChunkedSend::NEXT_OFFSET;
+    switch (m_chunkedSend.append(context.ChannelId(), transferId, offset, params.Data.Value()))
+    {
+        case ChunkedSend::UNKNOWN_TRANSFER:
+            LOGERR("Unknown chunked upload %u", transferId);
+            returnFailureResponse(FAILURE_TRANSFER_REJECTED, Core::ERROR_UNKNOWN_KEY);
+        case ChunkedSend::OUT_OF_ORDER:
+            LOGERR("Chunk at offset %u out of order for upload %u", params.Offset.Value(), transferId);
+            returnFailureResponse(FAILURE_TRANSFER_REJECTED, Core::ERROR_INVALID_RANGE);
+        case ChunkedSend::OVERRUN:
+            LOGERR("Chunk exceeds the declared size of upload %u", transferId);
+            returnFailureResponse(FAILURE_TRANSFER_REJECTED, Core::ERROR_INVALID_INPUT_LENGTH);
+        default:
+            break;
+    }
+    returnResponse(true);
+}
+
+// Method: sendEnd - Completes a chunked upload and sends the payload to the remote CAS
+// Return codes:
+//  - ERROR_NONE: Success
+//  - ERROR_UNKNOWN_KEY: No such upload on this connection
+//  - ERROR_INVALID_RANGE: Fewer bytes than declared were received, the upload is dropped
+//  - ERROR_INPROGRESS: The client exceeded its send rate or in-flight limit
+//  - ERROR_UNAVAILABLE: The plugin is deactivating
+uint32_t UnifiedCASManagement::sendEnd(const Core::JSONRPC::Context& context, const SendEndParamsData& params, JsonObject& response)
+{
+    bool success = false;
+
+    RequestScope scope(*this);
+    if(false == scope.admitted())
+    {
+        LOGERR("Plugin is deactivating");
+        returnFailureResponse(FAILURE_DEACTIVATING, Core::ERROR_UNAVAILABLE);
+    }
+    captureCall(TrafficLog::Kind::SEND_END, context.ChannelId(), params);
+
+    // Admitted like a send, so a rejected upload stays in place for the client to retry sendEnd.
+    SendThrottle::Ticket ticket(m_sendThrottle, context.ChannelId());
+    switch (ticket.admission())
+    {
+        case SendThrottle::RATE_LIMITED:
+            LOGWARN("Channel %u exceeded its send rate", context.ChannelId());
+            returnFailureResponse(FAILURE_RATE_LIMITED, Core::ERROR_INPROGRESS);
+        case SendThrottle::INFLIGHT_LIMITED:
+            LOGWARN("Channel %u has too many sends in flight", context.ChannelId());
+            returnFailureResponse(FAILURE_INFLIGHT_LIMITED, Core::ERROR_INPROGRESS);
+        case SendThrottle::CLIENTS_LIMITED:
+            LOGWARN("Channel %u refused, %u other clients are sending", context.ChannelId(), SendThrottle::MAX_CLIENTS);
+            returnFailureResponse(FAILURE_CLIENTS_LIMITED, Core::ERROR_INPROGRESS);
+        case SendThrottle::ADMITTED:
+            break;
+    }
+
+    const uint32_t transferId = params.Transferid.Value();
+    std::string data;
+    const ChunkedSend::Status status = m_chunkedSend.finish(context.ChannelId(), transferId, data);
+    updateTransferUsage();
+    switch (status)
+    {
+        case ChunkedSend::UNKNOWN_TRANSFER:
+            LOGERR("Unknown chunked upload %u", transferId);
+            returnFailureResponse(FAILURE_TRANSFER_REJECTED, Core::ERROR_UNKNOWN_KEY);
+        case ChunkedSend::INCOMPLETE:
+            LOGERR("Chunked upload %u ended before all data was received", transferId);
+            returnFailureResponse(FAILURE_TRANSFER_REJECTED, Core::ERROR_INVALID_RANGE);
+        default:
+            break;
+    }
+
+    const std::shared_ptr<MediaPlayer> player = currentPlayer();
+    if(nullptr == player)
+    {
+        LOGERR("NO VALID PLAYER AVAILABLE TO USE");
+        returnResponse(success);
+    }
+
+    LOGINFO("Sending chunked upload %u, %zu bytes", transferId, data.size());
+    MemoryBudget::Charge request(*m_memory, player->sessionId(), MemoryBudget::CATEGORY_REQUESTS, data.capacity());
+    if (false == player->requestCASData(data))
+    {
+        LOGERR("requestCASData failed");
+    }
+    else
+    {
+        success = true;
+    }
+    returnResponse(success);
+}
+
+// Method: openEventChannel - Opens the shared memory channel carrying raw data events
+// Return codes:
+//  - ERROR_NONE: Success
+//  - ERROR_UNAVAILABLE: The plugin is deactivating
+uint32_t UnifiedCASManagement::openEventChannel(const Core::JSONRPC::Context& context, const JsonObject& params, JsonObject& response)
+{
+    bool success = false;
+
+    RequestScope scope(*this);
+    if(false == scope.admitted())
+    {
+        LOGERR("Plugin is deactivating");
+        returnFailureResponse(FAILURE_DEACTIVATING, Core::ERROR_UNAVAILABLE);
+    }
+
+    const bool sized = params.HasLabel("size") && (Core::JSON::Variant::type::NUMBER == params["size"].Content());
+    const uint32_t size = sized ? static_cast<uint32_t>(params["size"].Number()) : m_eventRingSize;
+
+    std::lock_guard<std::mutex> lock(m_eventChannelLock);
+    // The ring is shared, so a later caller gets the size it was created with, unless that is too small.
+    if (sized && (0 != m_eventRing.capacity()) && (size > m_eventRing.capacity()))
+    {
+        LOGERR("Event channel is open with %u bytes, %u requested", m_eventRing.capacity(), size);
+    }
+    else if (false == m_eventRing.open("/" + m_callsign + ".events", size))
+    {
+        LOGERR("Failed to open the event channel");
+    }
+    else
+    {
+        ++m_eventChannelOpens[context.ChannelId()];
+        response["name"] = m_eventRing.name();
+        response["size"] = m_eventRing.capacity();
+        response["version"] = static_cast<uint32_t>(EventRing::VERSION);
+        success = true;
+    }
+    returnResponse(success);
+}
+
+// Method: closeEventChannel - Releases the shared memory event channel
+// Return codes:
+//  - ERROR_NONE: Success
+//  - ERROR_UNAVAILABLE: The plugin is deactivating
+uint32_t UnifiedCASManagement::closeEventChannel(const Core::JSONRPC::Context& context, const JsonObject& params, JsonObject& response)
+{
+    bool success = false;
+
+    RequestScope scope(*this);
+    if(false == scope.admitted())
+    {
+        LOGERR("Plugin is deactivating");
+        returnFailureResponse(FAILURE_DEACTIVATING, Core::ERROR_UNAVAILABLE);
+    }
+
+    std::lock_guard<std::mutex> lock(m_eventChannelLock);
+    std::map<uint32_t, uint32_t>::iterator opens = m_eventChannelOpens.find(context.ChannelId());
+    if (m_eventChannelOpens.end() == opens)
+    {
+        LOGERR("Event channel is not open on connection %u", context.ChannelId());
+    }
+    else
+    {
+        if (0 == --opens->second)
+        {
+            m_eventChannelOpens.erase(opens);
+        }
+        if (m_eventChannelOpens.empty())
+        {
+            m_eventRing.close();
+        }
+        success = true;
+    }
+    returnResponse(success);
+}
+
+// Method: setEventFilter - Restricts the data events sent to one client
+// Return codes:
+//  - ERROR_NONE: Success
+uint32_t UnifiedCASManagement::setEventFilter(const Core::JSONRPC::Context& context, const JsonObject& params, JsonObject& response)
+{
+    bool success = false;
+
+    returnIfStringParamNotFound(params, "id");
+
+    EventFilter filter;
+    filter.channelId = context.ChannelId();
+    if (params.HasLabel("source"))
+    {
+        filter.source = params["source"].String();
+    }
+    if (params.HasLabel("sessionid") && (Core::JSON::Variant::type::NUMBER == params["sessionid"].Content()))
+    {
+        filter.sessionId = static_cast<uint32_t>(params["sessionid"].Number());
+    }
+    if (params.HasLabel("prefix"))
+    {
+        filter.prefix = params["prefix"].String();
+    }
+
+    const std::string id = params["id"].String();
+    std::lock_guard<std::mutex> lock(m_eventFilterLock);
+    std::shared_ptr<EventFilterMap> filters = (nullptr != m_eventFilters) ? std::make_shared<EventFilterMap>(*m_eventFilters) : std::make_shared<EventFilterMap>();
+    EventFilterMap::iterator existing = filters->find(id);
+    if ((filters->end() != existing) && (existing->second.channelId != filter.channelId))
+    {
+        LOGERR("The event filter for %s belongs to another connection", id.c_str());
+    }
+    else if ((filters->size() >= MAX_EVENT_FILTERS) && (filters->end() == existing))
+    {
+        LOGERR("No more than %u event filters can be registered", MAX_EVENT_FILTERS);
+    }
+    else
+    {
+        (*filters)[id] = filter;
+        std::atomic_store(&m_eventFilters, std::shared_ptr<const EventFilterMap>(filters));
+        success = true;
+    }
+    returnResponse(success);
+}
+
+// Method: clearEventFilter - Lets one client receive all data events again
+// Return codes:
+//  - ERROR_NONE: Success
+uint32_t UnifiedCASManagement::clearEventFilter(const Core::JSONRPC::Context& context, const JsonObject& params, JsonObject& response)
+{
+    bool success = false;
+
+    returnIfStringParamNotFound(params, "id");
+
+    const std::string id = params["id"].String();
+    std::lock_guard<std::mutex> lock(m_eventFilterLock);
+    if ((nullptr == m_eventFilters) || (m_eventFilters->end() == m_eventFilters->find(id)))
+    {
+        LOGERR("No event filter registered for %s", id.c_str());
+    }
+    else if (m_eventFilters->at(id).channelId != context.ChannelId())
+    {
+        LOGERR("The event filter for %s belongs to another connection", id.c_str());
+    }
+    else
+    {
+        std::shared_ptr<EventFilterMap> filters = std::make_shared<EventFilterMap>(*m_eventFilters);
+        filters->erase(id);
+        std::atomic_store(&m_eventFilters, filters->empty() ? nullptr : std::shared_ptr<const EventFilterMap>(filters));
+        success = true;
+    }
+    returnResponse(success);
+}
+
+bool UnifiedCASManagement::sendsDataTo(
+     const std::shared_ptr<const EventFilterMap>& t_filters,
+     const std::string&                           t_designator,
+     const std::string&                           t_payload,
+     const std::string&                           t_source,
+     uint32_t                                     t_sessionId)
+{
+    if (nullptr == t_filters)
+    {
+        return true;
+    }
+    EventFilterMap::const_iterator filter = t_filters->find(t_designator);
+    return ((t_filters->end() == filter) || filter->second.matches(t_payload, t_source, t_sessionId));
+}
+
+void UnifiedCASManagement::dropEventFilters(uint32_t t_channelId)
+{
+    std::lock_guard<std::mutex> lock(m_eventFilterLock);
+    if (nullptr == m_eventFilters)
+    {
+        return;
+    }
+    std::shared_ptr<EventFilterMap> filters = std::make_shared<EventFilterMap>(*m_eventFilters);
+    for (EventFilterMap::iterator filter = filters->begin(); filter != filters->end();)
+    {
+        filter = (t_channelId == filter->second.channelId) ? filters->erase(filter) : std::next(filter);
+    }
+    if (filters->size() != m_eventFilters->size())
+    {
+        LOGINFO("Dropped %zu event filters of closed connection %u", m_eventFilters->size() - filters->size(), t_channelId);
+        std::atomic_store(&m_eventFilters, filters->empty() ? nullptr : std::shared_ptr<const EventFilterMap>(filters));
+    }
+}
+
+void UnifiedCASManagement::dropEventChannelOpens(uint32_t t_channelId)
+{
+    std::lock_guard<std::mutex> lock(m_eventChannelLock);
+    if ((0 != m_eventChannelOpens.erase(t_channelId)) && m_eventChannelOpens.empty())
+    {
+        LOGINFO("Closing the event channel, its last connection %u closed", t_channelId);
+        m_eventRing.close();
+    }
+}
+
+void UnifiedCASManagement::Close(const uint32_t channelId)
+{
+    // The filters, event channel opens, send limits and uploads of a connection go with it, so they neither outlive their client nor fill up the tables.
+    dropEventFilters(channelId);
+    dropEventChannelOpens(channelId);
+    m_sendThrottle.drop(channelId);
+    m_chunkedSend.drop(channelId);
+    updateTransferUsage();
+    PluginHost::JSONRPC::Close(channelId);
+}
+
+bool UnifiedCASManagement::claimReply(std::string& t_payload, const std::string& t_source, uint32_t t_sessionId)
+{
+    std::lock_guard<std::mutex> lock(m_replyLock);
+    if (m_pendingReplies.empty())
+    {
+        return false;
+    }
+
+    // A reply echoing our requestid goes to that send, anything else to the oldest send of the session.
+    std::list<PendingReply*>::iterator match = m_pendingReplies.end();
+    if ((false == t_payload.empty()) && ('{' == t_payload.front()))
+    {
+        JsonObject message;
+        if (message.FromString(t_payload) && message.HasLabel("requestid"))
+        {
+            const uint32_t requestId = static_cast<uint32_t>(message["requestid"].Number());
+            match = std::find_if(m_pendingReplies.begin(), m_pendingReplies.end(),
+                                 [requestId](const PendingReply* pending) { return pending->requestId == requestId; });
+        }
+    }
+    if (m_pendingReplies.end() == match)
+    {
+        match = std::find_if(m_pendingReplies.begin(), m_pendingReplies.end(),
+                             [t_sessionId](const PendingReply* pending) { return pending->sessionId == t_sessionId; });
+    }
+    if (m_pendingReplies.end() == match)
+    {
+        return false;
+    }
+
+    PendingReply* reply = *match;
+    m_pendingReplies.erase(match);
+    reply->payload = std::move(t_payload);
+    reply->source = t_source;
+    reply->done = true;
+    m_replySignal.notify_all();
+    return true;
+}
+
+void UnifiedCASManagement::cancelPendingReplies()
+{
+    std::lock_guard<std::mutex> lock(m_replyLock);
+    for (PendingReply* pending : m_pendingReplies)
+    {
+        pending->cancelled = true;
+    }
+    m_pendingReplies.clear();
+    m_replySignal.notify_all();
+}
+
+// Method: getStatistics - Reports plugin counters
+// Return codes:
+//  - ERROR_NONE: Success
+uint32_t UnifiedCASManagement::getStatistics(const JsonObject& params, JsonObject& response)
+{
+    JsonObject cache;
+    cache["enabled"] = m_responseCache.enabled();
+    cache["hits"] = m_responseCache.hits();
+    cache["misses"] = m_responseCache.misses();
+    cache["flushes"] = m_responseCache.flushes();
+    cache["entries"] = m_responseCache.size();
+    response["responsecache"] = cache;
+
+    JsonArray clients;
+    for (const SendThrottle::ClientStats& stats : m_sendThrottle.stats())
+    {
+        JsonObject client;
+        client["channel"] = stats.channelId;
+        client["inflight"] = stats.inflight;
+        client["admitted"] = stats.admitted;
+        client["ratelimited"] = stats.rateLimited;
+        client["inflightlimited"] = stats.inflightLimited;
+        clients.Add(client);
+    }
+    response["sendthrottle"] = clients;
+
+    JsonObject recovery;
+    recovery["attempted"] = m_recoveriesStarted.load();
+    recovery["recovered"] = m_recoveriesSucceeded.load();
+    recovery["failed"] = m_recoveriesFailed.load();
+    recovery["lastrecoverytime"] = m_lastRecoveryMs.load();
+    recovery["maxrecoverytime"] = m_maxRecoveryMs.load();
+    response["recovery"] = recovery;
+
+    JsonObject psiCache;
+    psiCache["enabled"] = m_psiCache.enabled();
+    psiCache["hits"] = m_psiCache.hits();
+    psiCache["misses"] = m_psiCache.misses();
+    psiCache["invalidations"] = m_psiCache.invalidations();
+    psiCache["entries"] = m_psiCache.size();
+    psiCache["timesaved"] = m_psiCache.timeSavedMs();
+    psiCache["lasttimesaved"] = m_psiCache.lastTimeSavedMs();
+    response["psicache"] = psiCache;
+
+    JsonObject scheduler;
+    {
+        std::lock_guard<std::mutex> lock(m_sessionLock);
+        scheduler["queued"] = m_scheduler.queued();
+        scheduler["waits"] = m_scheduler.waits();
+        scheduler["waittimeouts"] = m_scheduler.waitTimeouts();
+        scheduler["preemptions"] = m_scheduler.preemptions();
+    }
+    response["scheduler"] = scheduler;
+
+    // Only per-session memory is charged, the caches, event ring and traffic log are bounded by their own settings.
+    JsonObject memory;
+    memory["used"] = static_cast<uint64_t>(m_memory->used());
+    memory["peak"] = static_cast<uint64_t>(m_memory->peak());
+    memory["softlimit"] = static_cast<uint64_t>(m_memory->softLimit());
+    memory["hardlimit"] = static_cast<uint64_t>(m_memory->hardLimit());
+    memory["eventsshed"] = m_memory->eventsShed();
+    memory["transfersrejected"] = m_memory->transfersRejected();
+    memory["sessionsrefused"] = m_memory->sessionsRefused();
+    JsonArray sessions;
+    for (const MemoryBudget::SessionUsage& usage : m_memory->usage())
+    {
+        JsonObject session;
+        session["sessionid"] = usage.sessionId;
+        session["player"] = static_cast<uint64_t>(usage.bytes[MemoryBudget::CATEGORY_PLAYER]);
+        session["transfers"] = static_cast<uint64_t>(usage.bytes[MemoryBudget::CATEGORY_TRANSFERS]);
+        session["requests"] = static_cast<uint64_t>(usage.bytes[MemoryBudget::CATEGORY_REQUESTS]);
+        session["events"] = static_cast<uint64_t>(usage.bytes[MemoryBudget::CATEGORY_EVENTS]);
+        session["total"] = static_cast<uint64_t>(usage.total);
+        sessions.Add(session);
+    }
+    memory["sessions"] = sessions;
+    response["memory"] = memory;
+
+    if (nullptr != m_libMediaPlayer)
+    {
+        JsonObject module;
+        module["loaded"] = m_libMediaPlayer->loaded();
+        module["loads"] = m_libMediaPlayer->loads();
+        module["unloads"] = m_libMediaPlayer->unloads();
+        module["loadtime"] = m_libMediaPlayer->loadTimeMs();
+        response["libmediaplayer"] = module;
+    }
+    returnResponse(true);
+}
+
+// Event: data - Sent when the CAS needs to send data to the caller
+void UnifiedCASManagement::event_data(std::string payload, const std::string& source, uint32_t sessionId)
+{
+    if (m_traffic.active())
+    {
+        m_traffic.record(TrafficLog::Kind::DATA_EVENT, sessionId, payload, source);
+    }
+
+    m_eventRing.write(payload, source);
+
+    m_snapshot.updateCasState(payload);
+
+    m_psiCache.report(sessionId, payload);
+
+    if (m_responseCache.flushOn(payload))
+    {
+        LOGINFO("Entitlement change, response cache flushed");
+    }
+
+    // Replies to an awaited send are returned to that caller instead of being broadcast.
+    if (claimReply(payload, source, sessionId))
+    {
+        return;
+    }
+
+    // Serialized once, straight from the payload; Notify takes the text as it is.
+    const OutboundJson::Field fields[] = {
+        { "payload", payload },
+        { "source", source }
+    };
+    const std::string text = OutboundJson::serialize(fields, sizeof(fields) / sizeof(fields[0]));
+    LOGINFO("Notify %s %s", EVENT_DATA.c_str(), text.c_str());
+
+    const OutboundJson::Text params(text);
+    std::shared_ptr<const EventFilterMap> filters = std::atomic_load(&m_eventFilters);
+    if (nullptr == filters)
+    {
+        sendNotifySerialized(EVENT_DATA, params);
+    }
+    else
+    {
+        // Thunder consults the filter before any per-client work, so rejected clients cost neither a frame nor a socket write.
+        const std::function<bool(const string&)> sendIf = [&](const string& designator) -> bool {
+            return sendsDataTo(filters, designator, payload, source, sessionId);
+        };
+        sendNotifySerializedIf(EVENT_DATA, params, sendIf);
+    }
+
+    // Above the soft limit events are left out of databatch, as queuing them holds their copies; the seq number
+    // they still take shows batch consumers the gap. Otherwise the payload is not needed any more and moves into the batch.
+    if (false == m_eventBatcher.running())
+    {
+        return;
+    }
+    if (MemoryBudget::LEVEL_NORMAL != m_memory->level())
+    {
+        if (m_eventBatcher.skip())
+        {
+            m_memory->countEventShed();
+        }
+        return;
+    }
+    const std::size_t queued = payload.size() + source.size();
+    m_memory->charge(sessionId, MemoryBudget::CATEGORY_EVENTS, queued);
+    if (false == m_eventBatcher.add(std::move(payload), source, sessionId))
+    {
+        m_memory->release(sessionId, MemoryBudget::CATEGORY_EVENTS, queued);
+    }
+}
+
+void UnifiedCASManagement::onPlayerData(std::string&& t_payload, const std::string& t_source, uint32_t t_sessionId)
+{
+    event_data(std::move(t_payload), t_source, t_sessionId);
+}
+
+// Event: databatch - Sent with the data events collected over the configured window
+void UnifiedCASManagement::event_databatch(std::vector<EventBatcher::Entry>&& batch)
+{
+    JsonArray events;
+    for (const EventBatcher::Entry& entry : batch)
+    {
+        JsonObject event;
+        event["payload"] = entry.payload;
+        event["source"] = entry.source;
+        event["seq"] = entry.seq;
+        event["timestamp"] = entry.timestamp;
+        events.Add(event);
+    }
+
+    JsonObject params;
+    params["events"] = events;
+    sendNotify(EVENT_DATABATCH.c_str(), params);
+
+    for (const EventBatcher::Entry& entry : batch)
+    {
+        m_memory->release(entry.sessionId, MemoryBudget::CATEGORY_EVENTS, entry.payload.size() + entry.source.size());
+    }
+}
+
+// Event: sessionclosed - Sent when a management session has been torn down
+void UnifiedCASManagement::event_sessionclosed(uint32_t sessionId, bool success)
+{
+    JsonObject params;
+    params["sessionid"] = sessionId;
+    params["success"] = success;
+    sendNotify(EVENT_SESSIONCLOSED.c_str(), params);
+}
+
+// Event: sessionrecovering - Sent when a transient player error starts rebuilding a session
+void UnifiedCASManagement::event_sessionrecovering(uint32_t sessionId, int64_t code)
+{
+    JsonObject params;
+    params["sessionid"] = sessionId;
+    params["code"] = code;
+    sendNotify(EVENT_SESSIONRECOVERING.c_str(), params);
+}
+
+// Event: sessionpreempted - Sent when a session is closed for a manage request of higher priority
+void UnifiedCASManagement::event_sessionpreempted(uint32_t sessionId, SessionPriority priority)
+{
+    JsonObject params;
+    params["sessionid"] = sessionId;
+    params["priority"] = Core::JSON::EnumType<JsonData::UnifiedCASManagement::PriorityType>(JsonData::UnifiedCASManagement::toPriorityType(priority)).Data();
+    sendNotify(EVENT_SESSIONPREEMPTED.c_str(), params);
+}
+
+// Event: sessionrecovered - Sent when a session has been rebuilt after a transient player error
+void UnifiedCASManagement::event_sessionrecovered(uint32_t sessionId, uint32_t attempts, uint32_t recoveryTimeMs)
 {
     JsonObject params;
-    params["payload"] = payload;
-    params["source"] = source;
-    sendNotify(EVENT_DATA.c_str(), params);
+    params["sessionid"] = sessionId;
+    params["attempts"] = attempts;
+    params["recoverytime"] = recoveryTimeMs;
+    sendNotify(EVENT_SESSIONRECOVERED.c_str(), params);
 }
 
 } // namespace
@@ -20,8 +20,28 @@
 #ifndef UNIFIEDCASMANAGEMENT_H
 #define UNIFIEDCASMANAGEMENT_H
 
+#include <chrono>
+#include <condition_variable>
+#include <list>
+#include <map>
+#include <mutex>
+#include <set>
+#include <thread>
 #include "Module.h"
+#include "EventBatcher.h"
+#include "ChunkedSend.h"
+#include "EventRing.h"
+#include "MemoryBudget.h"
+#include "PsiCache.h"
+#include "ResponseCache.h"
+#include "SendThrottle.h"
+#include "TrafficLog.h"
+#include "SessionScheduler.h"
+#include "SessionSnapshot.h"
+#include "JsonData_UnifiedCASManagement.h"
 #include "MediaPlayer.h"
+#include "PlayerRegistry.h"
+#include "LibMediaPlayerModule.h"
 
 namespace WPEFramework 
 {
@@ -29,9 +49,311 @@ namespace WPEFramework
 namespace Plugin 
 {
 
-class UnifiedCASManagement : public PluginHost::IPlugin, public PluginHost::JSONRPC 
+class UnifiedCASManagement : public PluginHost::IPlugin, public PluginHost::JSONRPC, public MediaPlayerObserver
 {
 
+private:
+    class CacheRuleConfig : public Core::JSON::Container
+    {
+    public:
+        CacheRuleConfig()
+            : Core::JSON::Container()
+        {
+            Add(_T("prefix"), &Prefix);
+            Add(_T("ttl"), &Ttl);
+        }
+
+        CacheRuleConfig(const CacheRuleConfig& other)
+            : Core::JSON::Container()
+            , Prefix(other.Prefix)
+            , Ttl(other.Ttl)
+        {
+            Add(_T("prefix"), &Prefix);
+            Add(_T("ttl"), &Ttl);
+        }
+
+        CacheRuleConfig& operator=(const CacheRuleConfig& other)
+        {
+            Prefix = other.Prefix;
+            Ttl = other.Ttl;
+            return (*this);
+        }
+
+        Core::JSON::String    Prefix; //Leading bytes of the send payload naming the query type
+        Core::JSON::DecUInt32 Ttl; //Time (ms) a reply to this query type stays valid
+    };
+
+    class BackendRuleConfig : public Core::JSON::Container
+    {
+    public:
+        BackendRuleConfig()
+            : Core::JSON::Container()
+        {
+            Add(_T("manage"), &Manage);
+            Add(_T("backend"), &Backend);
+        }
+
+        BackendRuleConfig(const BackendRuleConfig& other)
+            : Core::JSON::Container()
+            , Manage(other.Manage)
+            , Backend(other.Backend)
+        {
+            Add(_T("manage"), &Manage);
+            Add(_T("backend"), &Backend);
+        }
+
+        BackendRuleConfig& operator=(const BackendRuleConfig& other)
+        {
+            Manage = other.Manage;
+            Backend = other.Backend;
+            return (*this);
+        }
+
+        Core::JSON::EnumType<ManageMode> Manage; //Manage mode the rule applies to
+        Core::JSON::String               Backend; //Registered player backend serving that mode
+    };
+
+    class ResponseCacheConfig : public Core::JSON::Container
+    {
+    public:
+        ResponseCacheConfig(const ResponseCacheConfig&) = delete;
+        ResponseCacheConfig& operator=(const ResponseCacheConfig&) = delete;
+
+        ResponseCacheConfig()
+            : Core::JSON::Container()
+        {
+            Add(_T("rules"), &Rules);
+            Add(_T("flushon"), &FlushOn);
+        }
+
+        Core::JSON::ArrayType<CacheRuleConfig>    Rules;
+        Core::JSON::ArrayType<Core::JSON::String> FlushOn; //Data event prefixes signalling an entitlement change
+    };
+
+    class PsiCacheConfig : public Core::JSON::Container
+    {
+    public:
+        PsiCacheConfig(const PsiCacheConfig&) = delete;
+        PsiCacheConfig& operator=(const PsiCacheConfig&) = delete;
+
+        PsiCacheConfig()
+            : Core::JSON::Container()
+            , Size(0)
+            , Prefix(_T("{\"psi\""))
+        {
+            Add(_T("size"), &Size);
+            Add(_T("prefix"), &Prefix);
+        }
+
+        Core::JSON::DecUInt32 Size; //Media URLs whose PSI is kept, 0 disables the cache
+        Core::JSON::String    Prefix; //Leading bytes of the data events reporting PSI
+    };
+
+    class MemoryConfig : public Core::JSON::Container
+    {
+    public:
+        MemoryConfig(const MemoryConfig&) = delete;
+        MemoryConfig& operator=(const MemoryConfig&) = delete;
+
+        MemoryConfig()
+            : Core::JSON::Container()
+            , SoftLimit(0)
+            , HardLimit(0)
+            , SessionFootprint(4 * 1024 * 1024)
+        {
+            Add(_T("softlimit"), &SoftLimit);
+            Add(_T("hardlimit"), &HardLimit);
+            Add(_T("sessionfootprint"), &SessionFootprint);
+        }
+
+        Core::JSON::DecUInt32 SoftLimit; //Bytes from which events are not batched and chunked uploads are refused, 0 disables it
+        Core::JSON::DecUInt32 HardLimit; //Bytes from which new sessions are refused, 0 disables it
+        Core::JSON::DecUInt32 SessionFootprint; //Bytes charged for the player instance of an open session
+    };
+
+    class Config : public Core::JSON::Container
+    {
+    public:
+        Config(const Config&) = delete;
+        Config& operator=(const Config&) = delete;
+
+        Config()
+            : Core::JSON::Container()
+            , DeferredUnmanage(false)
+            , TeardownTimeout(5000)
+            , DrainTimeout(3000)
+            , MaxWaitTimeout(30000)
+            , EventRingSize(1024 * 1024)
+            , SendTimeout(5000)
+            , RestoreSessions(false)
+            , SendRate(0)
+            , SendBurst(10)
+            , SendMaxInflight(0)
+            , BatchWindow(0)
+            , BatchSize(32)
+            , RecoveryAttempts(5)
+            , RecoveryBackoff(200)
+            , RecoveryBackoffMax(5000)
+            , MaxTransferSize(1024 * 1024)
+            , MaxTransfers(4)
+            , TransferTimeout(30000)
+            , PlayerUnloadDelay(0)
+            , CaptureMaxSize(TrafficLog::DEFAULT_MAX_SIZE)
+        {
+            Add(_T("deferredunmanage"), &DeferredUnmanage);
+            Add(_T("teardowntimeout"), &TeardownTimeout);
+            Add(_T("draintimeout"), &DrainTimeout);
+            Add(_T("maxwaittimeout"), &MaxWaitTimeout);
+            Add(_T("eventringsize"), &EventRingSize);
+            Add(_T("sendtimeout"), &SendTimeout);
+            Add(_T("responsecache"), &ResponseCache);
+            Add(_T("psicache"), &PsiCache);
+            Add(_T("restoresessions"), &RestoreSessions);
+            Add(_T("casstateprefix"), &CasStatePrefix);
+            Add(_T("sendrate"), &SendRate);
+            Add(_T("sendburst"), &SendBurst);
+            Add(_T("sendmaxinflight"), &SendMaxInflight);
+            Add(_T("batchwindow"), &BatchWindow);
+            Add(_T("batchsize"), &BatchSize);
+            Add(_T("transienterrors"), &TransientErrors);
+            Add(_T("fatalerrors"), &FatalErrors);
+            Add(_T("recoveryattempts"), &RecoveryAttempts);
+            Add(_T("recoverybackoff"), &RecoveryBackoff);
+            Add(_T("recoverybackoffmax"), &RecoveryBackoffMax);
+            Add(_T("maxtransfersize"), &MaxTransferSize);
+            Add(_T("maxtransfers"), &MaxTransfers);
+            Add(_T("transfertimeout"), &TransferTimeout);
+            Add(_T("playerbackend"), &PlayerBackend);
+            Add(_T("backends"), &Backends);
+            Add(_T("playerunloaddelay"), &PlayerUnloadDelay);
+            Add(_T("capturefile"), &CaptureFile);
+            Add(_T("capturemaxsize"), &CaptureMaxSize);
+            Add(_T("memory"), &Memory);
+        }
+
+        Core::JSON::Boolean   DeferredUnmanage; //Default for the "deferred" parameter of unmanage
+        Core::JSON::DecUInt32 TeardownTimeout; //Time (ms) a tuned manage waits for a deferred teardown to release the tuner
+        Core::JSON::DecUInt32 DrainTimeout; //Time (ms) Deinitialize waits for requests and sessions before giving up on them
+        Core::JSON::DecUInt32 MaxWaitTimeout; //Largest waittimeout (ms) a manage request may queue for
+        Core::JSON::DecUInt32 EventRingSize; //Default data area size (bytes) of the shared memory event channel
+        Core::JSON::DecUInt32 SendTimeout; //Default time (ms) send waits for the CAS reply when awaitresponse is set
+        ResponseCacheConfig   ResponseCache; //Replies to awaited sends served without a CAS round trip, off when empty
+        PsiCacheConfig        PsiCache; //PSI handed to MANAGE_FULL sessions re-tuning a media URL
+        Core::JSON::Boolean   RestoreSessions; //Reopen the session recorded in the snapshot on Initialize
+        Core::JSON::String    CasStatePrefix; //Leading bytes of the data events recorded as CAS state in the snapshot, off when empty
+        Core::JSON::DecUInt32 SendRate; //Sends per second each client may sustain, 0 for no limit
+        Core::JSON::DecUInt32 SendBurst; //Sends a client may issue at once after being idle
+        Core::JSON::DecUInt32 SendMaxInflight; //Sends a client may have executing at once, 0 for no limit
+        Core::JSON::DecUInt32 BatchWindow; //Time (ms) data events are collected into a databatch event, 0 disables it
+        Core::JSON::DecUInt32 BatchSize; //Number of data events delivering a databatch event before its window expires
+        Core::JSON::ArrayType<Core::JSON::DecSInt64> TransientErrors; //Player error codes answered by rebuilding the session
+        Core::JSON::ArrayType<Core::JSON::DecSInt64> FatalErrors; //Player error codes answered by closing the session
+        Core::JSON::DecUInt32 RecoveryAttempts; //Rebuild attempts before a session is given up
+        Core::JSON::DecUInt32 RecoveryBackoff; //Delay (ms) before the second rebuild attempt, doubled for every further one
+        Core::JSON::DecUInt32 RecoveryBackoffMax; //Upper bound (ms) of the delay between rebuild attempts
+        Core::JSON::DecUInt32 MaxTransferSize; //Largest payload (bytes) a chunked upload may declare
+        Core::JSON::DecUInt32 MaxTransfers; //Chunked uploads that may be in progress at once
+        Core::JSON::DecUInt32 TransferTimeout; //Time (ms) after which an idle chunked upload may be dropped
+        Core::JSON::String    PlayerBackend; //Player backend serving manage modes without a rule in Backends
+        Core::JSON::ArrayType<BackendRuleConfig> Backends; //Player backend per manage mode
+        Core::JSON::DecUInt32 PlayerUnloadDelay; //Time (ms) libmediaplayer stays loaded without a session, 0 keeps it loaded for good
+        Core::JSON::String    CaptureFile; //Traffic log recording calls and player callbacks for ucasreplay, off when empty
+        Core::JSON::DecUInt64 CaptureMaxSize; //Size (bytes) at which the traffic log stops growing
+        MemoryConfig          Memory; //Caps on the memory held for sessions
+    };
+
+    struct RetiredSession
+    {
+        std::shared_ptr<MediaPlayer>  player;
+        uint32_t                      sessionId;
+        bool                          tuned;
+        std::shared_ptr<MemoryBudget> memory; //Releases the player charge once the teardown is done
+    };
+
+    /**
+     * @brief   State shared between the plugin and its session teardown threads.
+     * @details Teardown threads only hold this state, never the plugin itself. They run plugin
+     *          code, so Deinitialize and the destructor join every one of them before returning.
+     */
+    struct TeardownState
+    {
+        std::mutex                 lock;
+        std::condition_variable    signal; //Signalled whenever a teardown finishes
+        UnifiedCASManagement*      owner = nullptr; //Receives sessionclosed events; cleared past the drain deadline
+        uint32_t                   pending = 0; //Teardowns still running
+        uint32_t                   pendingTuned = 0; //Running teardowns still holding a tuner
+        std::list<std::thread>     threads; //Teardown threads not joined yet
+        std::list<std::thread::id> finished; //Threads in threads that are done and can be joined at once
+    };
+
+    /**
+     * @brief   Subscription-time filter for data events, registered per client designator.
+     * @details Empty or zero fields match any value. Notify only reports the designator, so that
+     *          is the key; the connection that set the filter owns it until it closes.
+     */
+    struct EventFilter
+    {
+        uint32_t    channelId = 0; //Connection that set the filter, the only one allowed to change or clear it
+        std::string source;
+        uint32_t    sessionId = 0;
+        std::string prefix; //Leading bytes of the payload, e.g. a CAS message type tag
+
+        bool matches(const std::string& t_payload, const std::string& t_source, uint32_t t_sessionId) const
+        {
+            return ((source.empty() || (source == t_source)) &&
+                    ((0 == sessionId) || (sessionId == t_sessionId)) &&
+                    (0 == t_payload.compare(0, prefix.size(), prefix)));
+        }
+    };
+    typedef std::map<std::string, EventFilter> EventFilterMap;
+
+    static constexpr uint32_t MAX_EVENT_FILTERS = 32;
+
+    /**
+     * @brief   Outstanding send waiting for its reply from the CAS.
+     * @details Lives on the stack of the waiting send; event_data fills it in under m_replyLock.
+     */
+    struct PendingReply
+    {
+        uint32_t    requestId = 0;
+        uint32_t    sessionId = 0;
+        bool        done = false;
+        bool        cancelled = false;
+        std::string payload;
+        std::string source;
+    };
+
+    class RequestScope
+    {
+    public:
+        RequestScope() = delete;
+        RequestScope(const RequestScope&) = delete;
+        RequestScope& operator=(const RequestScope&) = delete;
+
+        explicit RequestScope(UnifiedCASManagement& t_parent)
+            : m_parent(t_parent)
+            , m_admitted(t_parent.beginRequest())
+        {
+        }
+
+        ~RequestScope()
+        {
+            if (m_admitted)
+            {
+                m_parent.endRequest();
+            }
+        }
+
+        bool admitted() const
+        {
+            return m_admitted;
+        }
+
+    private:
+        UnifiedCASManagement& m_parent;
+        const bool            m_admitted;
+    };
+
 public:
     UnifiedCASManagement();
     UnifiedCASManagement(const UnifiedCASManagement& orig) = delete;
@@ -49,25 +371,235 @@ public/*members*/:
     virtual void Deinitialize(PluginHost::IShell *service) override;
     virtual std::string Information() const override; 
 
-    void event_data(const std::string& payload, const std::string& source);
-    static UnifiedCASManagement* _instance;
+    void event_data(std::string payload, const std::string& source, uint32_t sessionId = 0);
+    void event_sessionclosed(uint32_t sessionId, bool success);
+    void event_databatch(std::vector<EventBatcher::Entry>&& batch);
+    void event_sessionrecovering(uint32_t sessionId, int64_t code);
+    void event_sessionrecovered(uint32_t sessionId, uint32_t attempts, uint32_t recoveryTimeMs);
+    void event_sessionpreempted(uint32_t sessionId, SessionPriority priority);
+
+    /**
+     * @brief     This method handles an error reported by the player of a session.
+     * @details   Transient errors rebuild the session, fatal errors close it and other codes are only
+     *            logged. Called on the player's callback thread, so the work is done on m_recoveryThread.
+     *
+     * @parm[in]  t_code      Error code reported by libmediaplayer.
+     * @parm[in]  t_sessionId Session served by the reporting player.
+     *
+     * @return    None
+     */
+    void onPlayerError(int64_t t_code, uint32_t t_sessionId) override;
+
+    //   IDispatcher::ILocal methods
+    // -------------------------------------------------------------------------------------------------------
+    void Close(const uint32_t channelId) override;
+
+    //   MediaPlayerObserver methods
+    // -------------------------------------------------------------------------------------------------------
+    void onPlayerData(std::string&& t_payload, const std::string& t_source, uint32_t t_sessionId) override;
 
     static const std::string METHOD_MANAGE;
     static const std::string METHOD_UNMANAGE;
     static const std::string METHOD_SEND;    
+    static const std::string METHOD_OPENEVENTCHANNEL;
+    static const std::string METHOD_CLOSEEVENTCHANNEL;
+    static const std::string METHOD_SETEVENTFILTER;
+    static const std::string METHOD_CLEAREVENTFILTER;
+    static const std::string METHOD_GETSTATISTICS;
+    static const std::string METHOD_SENDBEGIN;
+    static const std::string METHOD_SENDCHUNK;
+    static const std::string METHOD_SENDEND;
     static const std::string EVENT_DATA;    
+    static const std::string EVENT_SESSIONCLOSED;
+    static const std::string EVENT_DATABATCH;
+    static const std::string EVENT_SESSIONRECOVERING;
+    static const std::string EVENT_SESSIONRECOVERED;
+    static const std::string EVENT_SESSIONPREEMPTED;
+    static const std::string DEFAULT_BACKEND;
+
+    /**
+     * @brief Values reported in the "failurereason" field of a failed response.
+     */
+    enum FailureReason : uint32_t
+    {
+        FAILURE_NONE = 0,
+        FAILURE_SESSION_CONFLICT = 1, //A session with different parameters is already active
+        FAILURE_TUNER_BUSY = 2, //A deferred teardown did not release the tuner in time
+        FAILURE_DEACTIVATING = 3, //The plugin is being deactivated and accepts no new requests
+        FAILURE_REPLY_TIMEOUT = 4, //The CAS did not reply to an awaited send in time
+        FAILURE_RATE_LIMITED = 5, //The client exceeded its send rate
+        FAILURE_INFLIGHT_LIMITED = 6, //The client has too many sends executing
+        FAILURE_TRANSFER_REJECTED = 7, //A chunked upload was refused, the error code tells why
+        FAILURE_MEMORY_LIMITED = 8, //The plugin holds more memory than the configured cap allows
+        FAILURE_CLIENTS_LIMITED = 9 //Too many other clients are sending at once
+    };
+
+    /**
+     * @brief     This method hashes the parameters identifying a management session.
+     * @details   Leading and trailing whitespace is ignored so that equivalent requests hash equally.
+     *
+     * @return    Hash of the normalized parameters.
+     */
+    static std::size_t hashManageParams(
+                       const std::string& t_mediaurl,
+                       ManageMode         t_manage,
+                       const std::string& t_casinitdata,
+                       const std::string& t_casocdmid);
         
 private/*registered methods*/:
     void RegisterAll();
     void UnregisterAll();
 
+    static void teardownSession(
+                std::shared_ptr<TeardownState> t_state,
+                RetiredSession                 t_session);
+    void retireSession(RetiredSession&& t_session);
+    void joinTeardowns(bool t_all);
+    bool waitForTunerRelease(uint32_t t_timeoutMs);
+    bool beginRequest();
+    void endRequest();
+    void drainSessions();
+    bool claimReply(std::string& t_payload, const std::string& t_source, uint32_t t_sessionId);
+    void cancelPendingReplies();
+    bool openSessionLocked(const SessionSnapshot::Descriptor& t_session, std::size_t t_hash);
+    void restoreSession(SessionSnapshot::Descriptor t_session);
+    void handlePlayerError(int64_t t_code, uint32_t t_sessionId, bool t_fatal, std::chrono::steady_clock::time_point t_reported);
+    bool recoverSessionLocked(std::unique_lock<std::mutex>& t_lock, uint32_t& t_attempts);
+    template <typename PARAMS>
+    void captureCall(TrafficLog::Kind t_kind, uint32_t t_channel, const PARAMS& t_params)
+    {
+        if (m_traffic.active())
+        {
+            std::string text;
+            t_params.ToString(text);
+            m_traffic.record(t_kind, t_channel, text);
+        }
+    }
+    bool scheduleSessionLocked(std::unique_lock<std::mutex>& t_lock, SessionPriority t_priority, uint32_t t_waitMs);
+    void preemptSessionLocked(SessionPriority t_priority);
+    void joinRecoveryThread();
+    void updateTransferUsage();
+
 protected/*registered methods*/:
-    uint32_t manage(const JsonObject& params, JsonObject& response);
+    uint32_t manage(const JsonData::UnifiedCASManagement::ManageParamsData& params, JsonObject& response);
     uint32_t unmanage(const JsonObject& params, JsonObject& response);
-    uint32_t send(const JsonObject& params, JsonObject& response);
+    uint32_t send(const Core::JSONRPC::Context& context, const JsonData::UnifiedCASManagement::SendParamsData& params, JsonObject& response);
+    uint32_t openEventChannel(const Core::JSONRPC::Context& context, const JsonObject& params, JsonObject& response);
+    uint32_t closeEventChannel(const Core::JSONRPC::Context& context, const JsonObject& params, JsonObject& response);
+    uint32_t setEventFilter(const Core::JSONRPC::Context& context, const JsonObject& params, JsonObject& response);
+    uint32_t clearEventFilter(const Core::JSONRPC::Context& context, const JsonObject& params, JsonObject& response);
+
+    /**
+     * @brief     This method decides whether a data event is sent to one subscribed client.
+     *
+     * @parm[in]  t_filters    Filters in effect, nullptr when none are registered.
+     * @parm[in]  t_designator Designator the client registered for the event with.
+     *
+     * @return    true unless a filter registered for the designator rejects the event.
+     */
+    static bool sendsDataTo(
+                const std::shared_ptr<const EventFilterMap>& t_filters,
+                const std::string&                           t_designator,
+                const std::string&                           t_payload,
+                const std::string&                           t_source,
+                uint32_t                                     t_sessionId);
+    void dropEventFilters(uint32_t t_channelId);
+    void dropEventChannelOpens(uint32_t t_channelId);
+    uint32_t getStatistics(const JsonObject& params, JsonObject& response);
+    uint32_t sendBegin(const Core::JSONRPC::Context& context, const JsonData::UnifiedCASManagement::SendBeginParamsData& params, JsonObject& response);
+    uint32_t sendChunk(const Core::JSONRPC::Context& context, const JsonData::UnifiedCASManagement::SendChunkParamsData& params, JsonObject& response);
+    uint32_t sendEnd(const Core::JSONRPC::Context& context, const JsonData::UnifiedCASManagement::SendEndParamsData& params, JsonObject& response);
+
+    /**
+     * @brief     This method creates the player backing a new management session.
+     * @details   Called whenever the current player is handed over to a teardown thread.
+     *
+     * @return    New player instance, or nullptr when no player implementation is available.
+     */
+    virtual std::shared_ptr<MediaPlayer> createPlayer();
+    void replacePlayer();
+
+    /**
+     * @brief     This method returns the player of the current session.
+     * @details   Read under m_sessionLock. Requests use the returned copy only, so a player retired or
+     *            swapped meanwhile stays alive until they are done with it.
+     *
+     * @return    Current player, or nullptr when none is available.
+     */
+    std::shared_ptr<MediaPlayer> currentPlayer();
 
 protected/*members*/:
-    std::shared_ptr<MediaPlayer> m_player;
+    PlayerRegistry               m_playerRegistry; //Player backends built into this plugin
+    std::shared_ptr<LibMediaPlayerModule> m_libMediaPlayer; //Loaded on demand by the libmediaplayer backend
+    std::string                  m_defaultBackend = DEFAULT_BACKEND; //Configured backend of createPlayer()
+    std::string                  m_sessionBackends[sizeof(MANAGE_MODES) / sizeof(MANAGE_MODES[0])]; //Configured backend per ManageMode
+    std::string                  m_playerBackend; //Backend m_player was created from
+    std::shared_ptr<MediaPlayer> m_player; //Guarded by m_sessionLock; requests go through currentPlayer()
+    std::mutex                   m_sessionLock; //Serializes manage/unmanage against the session state below
+    bool                         m_sessionActive = false; //True while a management session is open on m_player
+    std::size_t                  m_sessionHash = 0; //Hash of the parameters the active session was opened with
+    uint32_t                     m_sessionId = 0; //Identifier of the most recently opened session
+    bool                         m_sessionTuned = false; //True when the active session holds a tuner
+    SessionScheduler             m_scheduler; //Arbitrates the session between manage requests of different priority
+    bool                         m_deferredUnmanage = false; //Configured default for deferred unmanage
+    uint32_t                     m_teardownTimeoutMs = 5000; //Configured tuner hand-off timeout
+    uint32_t                     m_drainTimeoutMs = 3000; //Configured Deinitialize deadline
+    uint32_t                     m_maxWaitTimeoutMs = 30000; //Configured bound of the manage waittimeout
+
+    std::shared_ptr<TeardownState> m_teardown; //Tracks sessions being torn down in the background
+    std::mutex                     m_requestLock; //Protects the request admission state below
+    std::condition_variable        m_requestsDone; //Signalled when the last in-flight request returns
+    uint32_t                       m_inflightRequests = 0; //Requests currently executing
+    bool                           m_deactivating = false; //Set by Deinitialize to refuse new requests
+
+    std::string                    m_callsign = "UnifiedCASManagement"; //Names the shared memory event channel
+    uint32_t                       m_eventRingSize = 1024 * 1024; //Configured event channel size
+    std::mutex                     m_eventChannelLock; //Serializes opening and closing of the event channel
+    std::map<uint32_t, uint32_t>   m_eventChannelOpens; //Opens of the event channel per JSON-RPC channel
+    EventRing                      m_eventRing; //Shared memory copy of every data event for native readers
+    EventBatcher                   m_eventBatcher; //Collects data events for the databatch event
+
+    std::mutex                            m_eventFilterLock; //Serializes updates of m_eventFilters
+    std::shared_ptr<const EventFilterMap> m_eventFilters; //Immutable snapshot read lock-free by event_data
+
+    uint32_t                       m_sendTimeoutMs = 5000; //Configured default reply timeout of an awaited send
+    std::mutex                     m_replyLock; //Protects m_pendingReplies and the entries it points to
+    std::condition_variable        m_replySignal; //Signalled when a pending reply is completed or cancelled
+    std::list<PendingReply*>       m_pendingReplies; //Awaited sends, oldest first
+    uint32_t                       m_nextRequestId = 0; //Last request identifier handed out, under m_replyLock
+
+    ResponseCache                  m_responseCache; //Configured replies to repeated awaited sends
+    PsiCache                       m_psiCache; //Last PSI reported per media URL
+    TrafficLog::Writer             m_traffic; //Capture of calls and callbacks, when configured
+    SendThrottle                   m_sendThrottle; //Per-channel rate and concurrency limits on send
+    ChunkedSend                    m_chunkedSend; //Chunked uploads in progress
+    std::shared_ptr<MemoryBudget>  m_memory; //Memory held per session, shared with the teardown threads
+    uint32_t                       m_sessionFootprint = 4 * 1024 * 1024; //Configured charge of an open player
+
+    SessionSnapshot                m_snapshot; //Memory-mapped record of the active session for warm restarts
+    std::thread                    m_restoreThread; //Reopens the recorded session after Initialize
+    std::condition_variable        m_sessionSettled; //Signalled when a restore or recovery released the session state
+    bool                           m_restoring = false; //Set while m_restoreThread owns the session state
+    bool                           m_sessionRestored = false; //The active session was reopened from the snapshot
+    std::string                    m_restoredCasState; //Last CAS state recorded for the restored session
+    SessionSnapshot::Descriptor    m_sessionDescriptor; //Parameters the active session was opened with
+
+    std::set<int64_t>              m_transientErrors; //Configured player errors triggering a rebuild
+    std::set<int64_t>              m_fatalErrors; //Configured player errors closing the session
+    uint32_t                       m_recoveryAttempts = 5; //Configured rebuild attempts
+    uint32_t                       m_recoveryBackoffMs = 200; //Configured initial delay between attempts
+    uint32_t                       m_recoveryBackoffMaxMs = 5000; //Configured upper bound of that delay
+    std::mutex                     m_recoveryThreadLock; //Serializes starting and joining m_recoveryThread
+    std::thread                    m_recoveryThread; //Handles the last transient or fatal player error
+    bool                           m_recoveryThreadBusy = false; //Guarded by m_recoveryThreadLock
+    std::condition_variable        m_recoveryCancel; //Signalled under m_sessionLock to cut a backoff short
+    bool                           m_recovering = false; //Set while m_recoveryThread owns the session state
+    bool                           m_sessionDeactivating = false; //m_deactivating under m_sessionLock: stops recoveries and queued manage requests
+    std::atomic<uint32_t>          m_recoveriesStarted { 0 };
+    std::atomic<uint32_t>          m_recoveriesSucceeded { 0 };
+    std::atomic<uint32_t>          m_recoveriesFailed { 0 };
+    std::atomic<uint32_t>          m_lastRecoveryMs { 0 }; //Time to recover of the last successful rebuild
+    std::atomic<uint32_t>          m_maxRecoveryMs { 0 }; //Longest time to recover since activation
         
 };
     